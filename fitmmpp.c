@@ -0,0 +1,501 @@
+//==================================================== file = fitmmpp.c =====
+//=  Program to fit H2, IPP, and MMPP parameters to an interarrival trace   =
+//===========================================================================
+//=  Notes: 1) Reads a user specified trace file of interarrival times (one =
+//=            per line) into memory                                        =
+//=         2) Writes the fitted parameters to a user specified file in the =
+//=            form the generators take them                                =
+//=             * H2 is lambda1, lambda2, and the probability for state 1   =
+//=               (one per line, in the order genhyp1.c prompts for them)   =
+//=             * IPP is lambda, alpha, and beta (one per line, in the      =
+//=               order genipp.c prompts for them)                          =
+//=             * MMPP is an MMPP file for genmmpp.c                        =
+//=         3) H2 is fit by EM of a two-phase exponential mixture           =
+//=         4) IPP interarrival times are H2 (Kuczura), so an IPP is fit as =
+//=            an H2 and converted back by inverting the IPP to H2          =
+//=            conversion in genipp.c.  With H2 rates mu1 > mu2 and         =
+//=            probability p1, lambda = p1 * mu1 + (1 - p1) * mu2,          =
+//=            beta = mu1 * mu2 / lambda, and                               =
+//=            alpha = mu1 + mu2 - lambda - beta.                           =
+//=         5) An n-state MMPP is fit by Baum-Welch EM of a hidden Markov   =
+//=            model with one state per interarrival time and exponential   =
+//=            emissions.  The per-arrival transition matrix P is then      =
+//=            converted to a generator with Q[i][j] = lambda_i * P[i][j],  =
+//=            which is accurate when the state changes slowly compared to  =
+//=            arrivals (the usual case for traffic).                       =
+//=         6) Forward-backward runs on chunks of FB_CHUNK interarrivals    =
+//=            that start from the current state occupancy.  The chunks are =
+//=            split across OpenMP threads (gcc -fopenmp) and run serially  =
+//=            otherwise.  EM sums over the trace are parallel the same way.=
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ---------------------------------------- fitmmpp.c -----              =
+//=   -  Program to fit H2, IPP, and MMPP parameters to an   -              =
+//=   -  interarrival trace                                  -              =
+//=   --------------------------------------------------------              =
+//=   Trace file name ====================================> trace.dat       =
+//=   Model (1 = H2, 2 = IPP, 3 = MMPP) ==================> 3               =
+//=   Number of MMPP states ==============================> 3               =
+//=   Output parameter file name =========================> mmpp.dat        =
+//=   --------------------------------------------------------              =
+//=   -  Fitting 398442 interarrival times                                  =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done! (log-likelihood = 1081258.248593)                            =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc -O3 -fopenmp fitmmpp.c -lm, bcc32 fitmmpp.c                 =
+//=-------------------------------------------------------------------------=
+//=  Execute: fitmmpp                                                       =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from genhyp2.c and genmmpp.c)           =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <math.h>               // Needed for log(), exp(), and fabs()
+
+//----- Defines -------------------------------------------------------------
+#define FIT_MAX_N     16        // Maximum number of MMPP states
+#define EM_MAX_ITER   500       // Maximum number of EM iterations
+#define EM_TOL        1.0e-9    // Relative log-likelihood change to stop
+#define FB_CHUNK      16384     // Interarrivals per forward-backward chunk
+
+//----- Function prototypes -------------------------------------------------
+double *load_trace(char *name, long *n);    // Reads a trace into memory
+double h2_fit_em(double *x, long n, double *p1, double *mu1, double *mu2);
+double hmm_fit_em(double *x, long n, int ns, double *rate, double *p);
+double fb_chunk(double *x, long len, int ns, double *pi0, double *rate,
+         double *p, double *sg, double *sgx, double *sxi);
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_out;               // File pointer to parameter file
+    char     instring[256];         // Input string
+    double   *x;                    // Interarrival trace
+    long     n;                     // Number of interarrival times
+    int      model;                 // 1 = H2, 2 = IPP, 3 = MMPP
+    int      ns;                    // Number of MMPP states
+    double   p1, mu1, mu2;          // H2 probability and rates
+    double   lambda, alpha, beta;   // IPP parameters
+    double   rate[FIT_MAX_N];       // MMPP arrival rates
+    double   p[FIT_MAX_N * FIT_MAX_N];  // Per-arrival transition matrix
+    double   q;                     // Generator entry
+    double   loglik;                // Log-likelihood of the fit
+    int      i, j;                  // Loop counters
+
+    // Output banner
+    printf("---------------------------------------- fitmmpp.c ----- \n");
+    printf("-  Program to fit H2, IPP, and MMPP parameters to an   - \n");
+    printf("-  interarrival trace                                  - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for trace filename and then read the trace
+    printf("Trace file name ====================================> ");
+    scanf("%s", instring);
+    x = load_trace(instring, &n);
+
+    // Prompt for the model (and number of states for an MMPP)
+    printf("Model (1 = H2, 2 = IPP, 3 = MMPP) ==================> ");
+    scanf("%s", instring);
+    model = atoi(instring);
+    ns = 2;
+    if (model == 3)
+    {
+        printf("Number of MMPP states ==============================> ");
+        scanf("%s", instring);
+        ns = atoi(instring);
+        if ((ns < 1) || (ns > FIT_MAX_N))
+        {
+            printf("ERROR - number of states must be 1 to %d \n", FIT_MAX_N);
+            exit(1);
+        }
+    }
+
+    // Prompt for output filename and then create/open the file
+    printf("Output parameter file name =========================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Output message and fit the model
+    printf("-------------------------------------------------------- \n");
+    printf("-  Fitting %ld interarrival times \n", n);
+    printf("-------------------------------------------------------- \n");
+    if (model == 3)
+    {
+        loglik = hmm_fit_em(x, n, ns, rate, p);
+        fprintf(fp_out, "%d \n", ns);
+        for (i = 0; i < ns; i++)
+            fprintf(fp_out, "%.10g ", rate[i]);
+        fprintf(fp_out, "\n");
+        for (i = 0; i < ns; i++)
+        {
+            q = 0.0;
+            for (j = 0; j < ns; j++)
+                if (j != i)
+                    q = q + rate[i] * p[i * ns + j];
+            for (j = 0; j < ns; j++)
+                fprintf(fp_out, "%.10g ",
+                    (j == i) ? -q : rate[i] * p[i * ns + j]);
+            fprintf(fp_out, "\n");
+        }
+    }
+    else
+    {
+        loglik = h2_fit_em(x, n, &p1, &mu1, &mu2);
+        if (model == 2)
+        {
+            lambda = p1 * mu1 + (1.0 - p1) * mu2;
+            beta = mu1 * mu2 / lambda;
+            alpha = mu1 + mu2 - lambda - beta;
+            fprintf(fp_out, "%.10g \n%.10g \n%.10g \n", lambda, alpha, beta);
+            printf("-    * lambda = %f, alpha = %f, beta = %f \n",
+                lambda, alpha, beta);
+        }
+        else
+        {
+            fprintf(fp_out, "%.10g \n%.10g \n%.10g \n", mu1, mu2, p1);
+            printf("-    * lambda1 = %f, lambda2 = %f, p1 = %f \n",
+                mu1, mu2, p1);
+        }
+    }
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! (log-likelihood = %f) \n", loglik);
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+    free(x);
+}
+
+//===========================================================================
+//=  Function to read a trace of interarrival times into memory             =
+//=    - Input:  Trace file name and pointer for the number of values       =
+//=    - Output: Returns a malloc()ed array of the values (exits on error)  =
+//===========================================================================
+double *load_trace(char *name, long *n)
+{
+    FILE     *fp_in;                // File pointer to trace file
+    double   *x;                    // Array of values
+    long     max_n;                 // Size of the x[] array
+
+    fp_in = fopen(name, "r");
+    if (fp_in == NULL)
+    {
+        printf("ERROR in opening trace file (%s) \n", name);
+        exit(1);
+    }
+
+    max_n = 1024;
+    *n = 0;
+    x = (double *) malloc(max_n * sizeof(double));
+    while ((x != NULL) && (fscanf(fp_in, "%lf", &x[*n]) == 1))
+    {
+        if (x[*n] < 0.0)
+        {
+            printf("ERROR - trace value %ld is negative \n", *n);
+            exit(1);
+        }
+        *n = *n + 1;
+        if (*n == max_n)
+        {
+            max_n = 2 * max_n;
+            x = (double *) realloc(x, max_n * sizeof(double));
+        }
+    }
+    if (x == NULL)
+    {
+        printf("ERROR - could not malloc space for trace \n");
+        exit(1);
+    }
+    if (*n < 2)
+    {
+        printf("ERROR - trace has fewer than 2 values \n");
+        exit(1);
+    }
+    fclose(fp_in);
+
+    return(x);
+}
+
+//===========================================================================
+//=  Function to fit an H2 to a trace using EM                              =
+//=    - Input:  Trace, number of values, and pointers for the results      =
+//=    - Output: Sets p1 and the rates mu1 > mu2 and returns the            =
+//=      log-likelihood                                                     =
+//=    - Starts from equal probabilities and means of 1/2 and 2 times the   =
+//=      trace mean.  The E-step sums are split across OpenMP threads.      =
+//===========================================================================
+double h2_fit_em(double *x, long n, double *p1, double *mu1, double *mu2)
+{
+    double   p[2], mean[2];         // Phase probabilities and means
+    double   lw0, lw1;              // log(p / mean) for each phase
+    double   sw0, sw1;              // Sums of responsibilities
+    double   swx0, swx1;            // Sums of responsibilities times values
+    double   w0, w1, big, tot;      // Log terms, largest, and normalizer
+    double   loglik, last_loglik;   // Log-likelihood of this and last step
+    double   x_mean;                // Mean of the trace
+    int      iter;                  // Iteration counter
+    long     i;                     // Loop counter
+
+    x_mean = 0.0;
+    for (i = 0; i < n; i++)
+        x_mean = x_mean + x[i];
+    x_mean = x_mean / n;
+    p[0] = p[1] = 0.5;
+    mean[0] = 0.5 * x_mean;
+    mean[1] = 2.0 * x_mean;
+
+    last_loglik = loglik = -HUGE_VAL;
+    for (iter = 0; iter < EM_MAX_ITER; iter++)
+    {
+        lw0 = log(p[0] / mean[0]);
+        lw1 = log(p[1] / mean[1]);
+        sw0 = sw1 = swx0 = swx1 = loglik = 0.0;
+
+        // E-step -- responsibilities of each phase for each value
+        #pragma omp parallel for private(w0, w1, big, tot) \
+            reduction(+:loglik, sw0, sw1, swx0, swx1)
+        for (i = 0; i < n; i++)
+        {
+            w0 = lw0 - x[i] / mean[0];
+            w1 = lw1 - x[i] / mean[1];
+            big = (w0 > w1) ? w0 : w1;
+            w0 = exp(w0 - big);
+            w1 = exp(w1 - big);
+            tot = w0 + w1;
+            loglik = loglik + big + log(tot);
+            sw0 = sw0 + w0 / tot;
+            sw1 = sw1 + w1 / tot;
+            swx0 = swx0 + x[i] * w0 / tot;
+            swx1 = swx1 + x[i] * w1 / tot;
+        }
+
+        // M-step -- new probabilities and means
+        p[0] = sw0 / n;
+        p[1] = sw1 / n;
+        if (sw0 > 0.0)
+            mean[0] = swx0 / sw0;
+        if (sw1 > 0.0)
+            mean[1] = swx1 / sw1;
+
+        if (fabs(loglik - last_loglik) < EM_TOL * fabs(loglik))
+            break;
+        last_loglik = loglik;
+    }
+
+    // Report the faster phase as phase 1
+    if (mean[0] <= mean[1])
+    {
+        *p1 = p[0];
+        *mu1 = 1.0 / mean[0];
+        *mu2 = 1.0 / mean[1];
+    }
+    else
+    {
+        *p1 = p[1];
+        *mu1 = 1.0 / mean[1];
+        *mu2 = 1.0 / mean[0];
+    }
+
+    return(loglik);
+}
+
+//===========================================================================
+//=  Function to fit an HMM with exponential emissions using Baum-Welch EM  =
+//=    - Input:  Trace, number of values, number of states, and arrays for  =
+//=      the results                                                        =
+//=    - Output: Sets rate[i] (arrival rate in state i) and p[i * ns + j]   =
+//=      (probability that the next interarrival is in state j) and         =
+//=      returns the log-likelihood                                         =
+//=    - Starts from rates spread by factors of 4 around the trace rate     =
+//=      and a sticky P (0.9 on the diagonal)                               =
+//===========================================================================
+double hmm_fit_em(double *x, long n, int ns, double *rate, double *p)
+{
+    double   pi0[FIT_MAX_N];        // State occupancy at a chunk start
+    double   sg[FIT_MAX_N];         // Sum of state probabilities
+    double   sgx[FIT_MAX_N];        // Sum of state probabilities times x
+    double   sxi[FIT_MAX_N * FIT_MAX_N];  // Sum of transition probabilities
+    double   loglik, last_loglik;   // Log-likelihood of this and last step
+    double   x_mean;                // Mean of the trace
+    double   sum;                   // Row sum
+    long     num_chunk;             // Number of chunks
+    long     c;                     // Chunk counter
+    long     len;                   // Length of a chunk
+    int      iter;                  // Iteration counter
+    int      i, j;                  // Loop counters
+
+    x_mean = 0.0;
+    for (c = 0; c < n; c++)
+        x_mean = x_mean + x[c];
+    x_mean = x_mean / n;
+    for (i = 0; i < ns; i++)
+    {
+        rate[i] = pow(4.0, 0.5 * (ns - 1) - i) / x_mean;
+        pi0[i] = 1.0 / ns;
+        for (j = 0; j < ns; j++)
+            p[i * ns + j] = (ns == 1) ? 1.0 :
+                ((i == j) ? 0.9 : (0.1 / (ns - 1)));
+    }
+
+    num_chunk = (n + FB_CHUNK - 1) / FB_CHUNK;
+    last_loglik = loglik = -HUGE_VAL;
+    for (iter = 0; iter < EM_MAX_ITER; iter++)
+    {
+        for (i = 0; i < ns; i++)
+        {
+            sg[i] = sgx[i] = 0.0;
+            for (j = 0; j < ns; j++)
+                sxi[i * ns + j] = 0.0;
+        }
+        loglik = 0.0;
+
+        // E-step -- forward-backward over the chunks in parallel
+        #pragma omp parallel for private(len) schedule(dynamic) \
+            reduction(+:loglik, sg[:FIT_MAX_N], sgx[:FIT_MAX_N], \
+                sxi[:FIT_MAX_N * FIT_MAX_N])
+        for (c = 0; c < num_chunk; c++)
+        {
+            len = n - c * FB_CHUNK;
+            if (len > FB_CHUNK)
+                len = FB_CHUNK;
+            loglik = loglik + fb_chunk(&x[c * FB_CHUNK], len, ns, pi0,
+                rate, p, sg, sgx, sxi);
+        }
+
+        // M-step -- new rates, transition matrix, and occupancy
+        for (i = 0; i < ns; i++)
+        {
+            if (sgx[i] > 0.0)
+                rate[i] = sg[i] / sgx[i];
+            pi0[i] = sg[i] / n;
+            sum = 0.0;
+            for (j = 0; j < ns; j++)
+                sum = sum + sxi[i * ns + j];
+            if (sum > 0.0)
+                for (j = 0; j < ns; j++)
+                    p[i * ns + j] = sxi[i * ns + j] / sum;
+        }
+
+        if (fabs(loglik - last_loglik) < EM_TOL * fabs(loglik))
+            break;
+        last_loglik = loglik;
+    }
+
+    return(loglik);
+}
+
+//===========================================================================
+//=  Function to run scaled forward-backward on one chunk of the trace      =
+//=    - Input:  Chunk of the trace, its length, number of states, start    =
+//=      distribution, rates, and transition matrix                         =
+//=    - Output: Adds the chunk's expected state counts (sg), state counts  =
+//=      times x (sgx), and transition counts (sxi) and returns the         =
+//=      chunk's log-likelihood                                             =
+//=    - Emissions are scaled by their largest term per step so that long   =
+//=      gaps do not underflow                                              =
+//===========================================================================
+double fb_chunk(double *x, long len, int ns, double *pi0, double *rate,
+         double *p, double *sg, double *sgx, double *sxi)
+{
+    double   *e;                    // Scaled emissions, len rows of ns
+    double   *a;                    // Scaled forward variables
+    double   *sc;                   // Scale factor of each step
+    double   b[FIT_MAX_N];          // Backward variables at step t + 1
+    double   bn[FIT_MAX_N];         // Backward variables at step t
+    double   lrate[FIT_MAX_N];      // log(rate) for each state
+    double   big, sum, g;           // Largest log term, sums, and prob
+    double   loglik;                // Log-likelihood of the chunk
+    long     t;                     // Step in the chunk
+    int      i, j;                  // Loop counters
+
+    e = (double *) malloc(len * ns * sizeof(double));
+    a = (double *) malloc(len * ns * sizeof(double));
+    sc = (double *) malloc(len * sizeof(double));
+    if ((e == NULL) || (a == NULL) || (sc == NULL))
+    {
+        printf("ERROR - could not malloc space for forward-backward \n");
+        exit(1);
+    }
+    for (i = 0; i < ns; i++)
+        lrate[i] = log(rate[i]);
+
+    // Scaled emissions (the scale goes into the log-likelihood)
+    loglik = 0.0;
+    for (t = 0; t < len; t++)
+    {
+        big = -HUGE_VAL;
+        for (i = 0; i < ns; i++)
+        {
+            e[t * ns + i] = lrate[i] - rate[i] * x[t];
+            if (e[t * ns + i] > big)
+                big = e[t * ns + i];
+        }
+        for (i = 0; i < ns; i++)
+            e[t * ns + i] = exp(e[t * ns + i] - big);
+        loglik = loglik + big;
+    }
+
+    // Forward pass
+    for (t = 0; t < len; t++)
+    {
+        sum = 0.0;
+        for (j = 0; j < ns; j++)
+        {
+            g = 0.0;
+            if (t == 0)
+                g = pi0[j];
+            else
+                for (i = 0; i < ns; i++)
+                    g = g + a[(t - 1) * ns + i] * p[i * ns + j];
+            a[t * ns + j] = g * e[t * ns + j];
+            sum = sum + a[t * ns + j];
+        }
+        sc[t] = sum;
+        for (j = 0; j < ns; j++)
+            a[t * ns + j] = a[t * ns + j] / sum;
+        loglik = loglik + log(sum);
+    }
+
+    // Backward pass with the expected counts
+    for (i = 0; i < ns; i++)
+        b[i] = 1.0;
+    for (t = len - 1; t >= 0; t--)
+    {
+        for (i = 0; i < ns; i++)
+        {
+            g = a[t * ns + i] * b[i];
+            sg[i] = sg[i] + g;
+            sgx[i] = sgx[i] + g * x[t];
+        }
+        if (t == 0)
+            break;
+        for (i = 0; i < ns; i++)
+        {
+            bn[i] = 0.0;
+            for (j = 0; j < ns; j++)
+            {
+                g = p[i * ns + j] * e[t * ns + j] * b[j] / sc[t];
+                bn[i] = bn[i] + g;
+                sxi[i * ns + j] = sxi[i * ns + j] + a[(t - 1) * ns + i] * g;
+            }
+        }
+        for (i = 0; i < ns; i++)
+            b[i] = bn[i];
+    }
+
+    free(e);
+    free(a);
+    free(sc);
+    return(loglik);
+}
+
@@ -0,0 +1,524 @@
+//==================================================== file = fitzipf.c =====
+//=  Program to fit Zipf alpha and N parameters to a key trace              =
+//===========================================================================
+//=  Notes: 1) Reads a user specified trace file of keys (one per line, any =
+//=            string up to the first white space) in a single pass         =
+//=         2) Writes alpha and N (one per line, in the order genzipf.c     =
+//=            prompts for them) to a user specified file                   =
+//=         3) Keys are counted by their 64-bit FNV-1a hash in a linear     =
+//=            probing hash table of at most a user specified number of     =
+//=            keys, so memory is bounded no matter how long the trace is   =
+//=         4) When the table is full a new key replaces the key with the   =
+//=            smallest count (Space-Saving, Metwally et al.).  The table   =
+//=            then keeps a min-heap on count and each key's overestimate,  =
+//=            and only keys whose guaranteed count is above the smallest   =
+//=            count are used for the fit                                   =
+//=         5) alpha is the maximum likelihood estimate for the counted     =
+//=            ranks 1 to K (found by safeguarded Newton iteration).  N is  =
+//=            K if every key was counted, otherwise it is the N for which  =
+//=            ranks 1 to K carry the fraction of events they had in the    =
+//=            trace.  The likelihood sums are split across OpenMP threads  =
+//=            (gcc -fopenmp) and run serially otherwise.                   =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ---------------------------------------- fitzipf.c -----              =
+//=   -  Program to fit Zipf parameters to a key trace       -              =
+//=   --------------------------------------------------------              =
+//=   Trace file name ====================================> trace.dat       =
+//=   Maximum number of keys to count ====================> 100000          =
+//=   Output parameter file name =========================> zipf.dat        =
+//=   --------------------------------------------------------              =
+//=   -  Counting keys                                       -              =
+//=   --------------------------------------------------------              =
+//=   -    * 1000000 events, 1000 keys counted                              =
+//=   -    * alpha = 1.000066, N = 1000                                     =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc -O3 -fopenmp fitzipf.c -lm, bcc32 fitzipf.c                 =
+//=-------------------------------------------------------------------------=
+//=  Execute: fitzipf                                                       =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from fitmmpp.c)                         =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <stdint.h>             // Needed for uint64_t
+#include <math.h>               // Needed for log(), exp(), and pow()
+
+//----- Defines -------------------------------------------------------------
+#define FZ_ALPHA_MAX  20.0      // Largest alpha that is searched
+#define FZ_MAX_ITER   100       // Maximum number of Newton iterations
+#define FZ_TOL        1.0e-12   // Alpha tolerance to stop
+#define FZ_EXACT      100000    // Terms summed exactly by zipf_h()
+#define FZ_N_MAX      1.0e15    // Largest N that is searched
+#define FZ_IO_BUF     (1 << 20) // Size of the trace read buffer
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                  // Space-Saving key counter
+{
+    long     max_keys;          // Maximum number of keys
+    long     num_keys;          // Number of keys in the table
+    uint64_t mask;              // Number of hash slots - 1
+    long     *slot;             // Hash slots (key index or -1)
+    uint64_t *key;              // Key hash of each key
+    uint64_t *count;            // Count of each key
+    uint64_t *err;              // Overestimate of each key's count
+    long     *heap;             // Min-heap of keys on count (when full)
+    long     *pos;              // Heap position of each key
+    uint64_t total;             // Number of events counted
+} ss_t;
+
+//----- Function prototypes -------------------------------------------------
+void     ss_init(ss_t *ss, long max_keys);  // Allocate a key counter
+void     ss_add(ss_t *ss, uint64_t h);      // Count one key
+long     ss_slot(ss_t *ss, uint64_t h);     // Find a key's hash slot
+void     ss_remove(ss_t *ss, uint64_t h);   // Remove a key's hash slot
+void     ss_sift(ss_t *ss, long k);         // Sift a heap entry down
+uint64_t fnv1a(char *s);                    // 64-bit FNV-1a string hash
+int      cmp_desc(const void *a, const void *b);   // qsort() comparator
+double   zipf_fit(uint64_t *f, long k);     // MLE of alpha for ranks 1..k
+double   zipf_h(double n, double alpha);    // Sum of i^-alpha for 1..n
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_in;                // File pointer to trace file
+    FILE     *fp_out;               // File pointer to parameter file
+    char     instring[256];         // Input string
+    char     line[4096];            // Line of the trace
+    char     *s;                    // Pointer into line
+    ss_t     ss;                    // Key counter
+    uint64_t *f;                    // Counts in rank order
+    uint64_t min_count;             // Smallest count in a full table
+    double   m_top;                 // Events in the counted ranks
+    double   target;                // Zipf sum that N must reach
+    double   lo, hi, mid;           // Bisection bounds for N
+    double   alpha;                 // Fitted alpha
+    double   n;                     // Fitted N
+    long     max_keys;              // Maximum number of keys to count
+    long     k;                     // Number of ranks used for the fit
+    long     i;                     // Loop counter
+
+    // Output banner
+    printf("---------------------------------------- fitzipf.c ----- \n");
+    printf("-  Program to fit Zipf parameters to a key trace       - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for trace filename and then open the file
+    printf("Trace file name ====================================> ");
+    scanf("%s", instring);
+    fp_in = fopen(instring, "r");
+    if (fp_in == NULL)
+    {
+        printf("ERROR in opening trace file (%s) \n", instring);
+        exit(1);
+    }
+    setvbuf(fp_in, NULL, _IOFBF, FZ_IO_BUF);
+
+    // Prompt for the memory bound
+    printf("Maximum number of keys to count ====================> ");
+    scanf("%s", instring);
+    max_keys = atol(instring);
+    if (max_keys < 2)
+    {
+        printf("ERROR - maximum number of keys must be at least 2 \n");
+        exit(1);
+    }
+
+    // Prompt for output filename and then create/open the file
+    printf("Output parameter file name =========================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Output message and count the keys in one pass
+    printf("-------------------------------------------------------- \n");
+    printf("-  Counting keys                                       - \n");
+    printf("-------------------------------------------------------- \n");
+    ss_init(&ss, max_keys);
+    while (fgets(line, sizeof(line), fp_in) != NULL)
+    {
+        for (s = line; (*s == ' ') || (*s == '\t'); s++)
+            ;
+        if ((*s == '\n') || (*s == '\r') || (*s == '\0'))
+            continue;
+        ss_add(&ss, fnv1a(s));
+    }
+    fclose(fp_in);
+    if (ss.num_keys < 2)
+    {
+        printf("ERROR - trace has fewer than 2 different keys \n");
+        exit(1);
+    }
+
+    // Guaranteed counts in rank order (only those above the smallest
+    // count are kept if keys were replaced)
+    f = (uint64_t *) malloc(ss.num_keys * sizeof(uint64_t));
+    if (f == NULL)
+    {
+        printf("ERROR - could not malloc space for ranks \n");
+        exit(1);
+    }
+    min_count = (ss.heap != NULL) ? ss.count[ss.heap[0]] : 0;
+    k = 0;
+    for (i = 0; i < ss.num_keys; i++)
+        if ((ss.heap == NULL) || (ss.count[i] - ss.err[i] > min_count))
+            f[k++] = ss.count[i] - ss.err[i];
+    if (k < 2)
+    {
+        printf("ERROR - fewer than 2 keys have exact counts, so the \n");
+        printf("        maximum number of keys must be increased \n");
+        exit(1);
+    }
+    qsort(f, k, sizeof(uint64_t), cmp_desc);
+
+    // Fit alpha on ranks 1 to k
+    alpha = zipf_fit(f, k);
+
+    // Fit N so that ranks 1 to k carry their share of the events
+    n = k;
+    if (ss.heap != NULL)
+    {
+        m_top = 0.0;
+        for (i = 0; i < k; i++)
+            m_top = m_top + f[i];
+        target = zipf_h(k, alpha) * (ss.total / m_top);
+        lo = k;
+        hi = FZ_N_MAX;
+        if (zipf_h(hi, alpha) < target)
+        {
+            printf("-    * WARNING - N is unbounded, so N = %.0f is used \n",
+                FZ_N_MAX);
+            lo = hi;
+        }
+        while (hi - lo > 0.5)
+        {
+            mid = floor(0.5 * (lo + hi));
+            if (zipf_h(mid, alpha) < target)
+                lo = mid + 1.0;
+            else
+                hi = mid;
+        }
+        n = lo;
+    }
+
+    // Output the parameters
+    fprintf(fp_out, "%.10g \n%.0f \n", alpha, n);
+    printf("-    * %llu events, %ld keys counted \n",
+        (unsigned long long) ss.total, k);
+    printf("-    * alpha = %f, N = %.0f \n", alpha, n);
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+    free(f);
+}
+
+//===========================================================================
+//=  Function to allocate a Space-Saving key counter                        =
+//=    - Input:  Counter and maximum number of keys                         =
+//=    - Output: Allocates an empty table with at least 2 hash slots per    =
+//=      key (exits on error)                                               =
+//===========================================================================
+void ss_init(ss_t *ss, long max_keys)
+{
+    long     num_slot;              // Number of hash slots
+    long     i;                     // Loop counter
+
+    for (num_slot = 2; num_slot < 2 * max_keys; num_slot = 2 * num_slot)
+        ;
+    ss->max_keys = max_keys;
+    ss->num_keys = 0;
+    ss->mask = num_slot - 1;
+    ss->total = 0;
+    ss->heap = NULL;
+    ss->slot = (long *) malloc(num_slot * sizeof(long));
+    ss->key = (uint64_t *) malloc(max_keys * sizeof(uint64_t));
+    ss->count = (uint64_t *) malloc(max_keys * sizeof(uint64_t));
+    ss->err = (uint64_t *) malloc(max_keys * sizeof(uint64_t));
+    ss->pos = (long *) malloc(max_keys * sizeof(long));
+    if ((ss->slot == NULL) || (ss->key == NULL) || (ss->count == NULL) ||
+        (ss->err == NULL) || (ss->pos == NULL))
+    {
+        printf("ERROR - could not malloc space for %ld keys \n", max_keys);
+        exit(1);
+    }
+    for (i = 0; i < num_slot; i++)
+        ss->slot[i] = -1;
+}
+
+//===========================================================================
+//=  Function to count one key                                              =
+//=    - Input:  Counter and key hash                                       =
+//=    - Output: Adds one to the key's count.  A new key fills the next     =
+//=      free entry or, when the table is full, replaces the key with the   =
+//=      smallest count and takes that count plus one as its count.         =
+//=    - The min-heap is only built (and kept) once the table is full       =
+//===========================================================================
+void ss_add(ss_t *ss, uint64_t h)
+{
+    long     s;                     // Hash slot
+    long     e;                     // Key index
+    long     i;                     // Loop counter
+
+    ss->total++;
+    s = ss_slot(ss, h);
+    e = ss->slot[s];
+
+    // Key is in the table
+    if (e >= 0)
+    {
+        ss->count[e]++;
+        if (ss->heap != NULL)
+            ss_sift(ss, ss->pos[e]);
+        return;
+    }
+
+    // Table has room for a new key (build the heap when it fills)
+    if (ss->num_keys < ss->max_keys)
+    {
+        e = ss->num_keys++;
+        ss->key[e] = h;
+        ss->count[e] = 1;
+        ss->err[e] = 0;
+        ss->slot[s] = e;
+        if (ss->num_keys == ss->max_keys)
+        {
+            ss->heap = (long *) malloc(ss->max_keys * sizeof(long));
+            if (ss->heap == NULL)
+            {
+                printf("ERROR - could not malloc space for heap \n");
+                exit(1);
+            }
+            for (i = 0; i < ss->max_keys; i++)
+            {
+                ss->heap[i] = i;
+                ss->pos[i] = i;
+            }
+            for (i = ss->max_keys / 2 - 1; i >= 0; i--)
+                ss_sift(ss, i);
+        }
+        return;
+    }
+
+    // Table is full so replace the key with the smallest count
+    e = ss->heap[0];
+    ss_remove(ss, ss->key[e]);
+    ss->key[e] = h;
+    ss->err[e] = ss->count[e];
+    ss->count[e]++;
+    ss->slot[ss_slot(ss, h)] = e;
+    ss_sift(ss, 0);
+}
+
+//===========================================================================
+//=  Function to find a key's hash slot (linear probing)                    =
+//=    - Input:  Counter and key hash                                       =
+//=    - Output: Returns the slot holding the key or the empty slot where   =
+//=      it would go                                                        =
+//===========================================================================
+long ss_slot(ss_t *ss, uint64_t h)
+{
+    long     s;                     // Hash slot
+
+    s = (long) (h & ss->mask);
+    while ((ss->slot[s] >= 0) && (ss->key[ss->slot[s]] != h))
+        s = (long) ((s + 1) & ss->mask);
+
+    return(s);
+}
+
+//===========================================================================
+//=  Function to remove a key from the hash slots                           =
+//=    - Input:  Counter and key hash (must be in the table)                =
+//=    - Output: Empties the key's slot and shifts back later keys of its   =
+//=      probe run so that no tombstones are needed                         =
+//===========================================================================
+void ss_remove(ss_t *ss, uint64_t h)
+{
+    long     s;                     // Slot being emptied
+    long     j;                     // Slot being checked
+    long     home;                  // Home slot of the key in slot j
+
+    s = ss_slot(ss, h);
+    ss->slot[s] = -1;
+    for (j = (long) ((s + 1) & ss->mask); ss->slot[j] >= 0;
+         j = (long) ((j + 1) & ss->mask))
+    {
+        // Move the key back unless its home is cyclically in (s, j]
+        home = (long) (ss->key[ss->slot[j]] & ss->mask);
+        if ((s < j) ? ((home <= s) || (home > j)) :
+                      ((home <= s) && (home > j)))
+        {
+            ss->slot[s] = ss->slot[j];
+            ss->slot[j] = -1;
+            s = j;
+        }
+    }
+}
+
+//===========================================================================
+//=  Function to sift a min-heap entry down after its count went up         =
+//=    - Input:  Counter and heap position                                  =
+//=    - Output: Restores the heap order and the pos[] index                =
+//===========================================================================
+void ss_sift(ss_t *ss, long k)
+{
+    long     e;                     // Key index being sifted
+    long     c;                     // Smaller child position
+
+    e = ss->heap[k];
+    for (c = 2 * k + 1; c < ss->max_keys; c = 2 * k + 1)
+    {
+        if ((c + 1 < ss->max_keys) &&
+            (ss->count[ss->heap[c + 1]] < ss->count[ss->heap[c]]))
+            c++;
+        if (ss->count[e] <= ss->count[ss->heap[c]])
+            break;
+        ss->heap[k] = ss->heap[c];
+        ss->pos[ss->heap[k]] = k;
+        k = c;
+    }
+    ss->heap[k] = e;
+    ss->pos[e] = k;
+}
+
+//===========================================================================
+//=  Function to hash a key string with 64-bit FNV-1a                       =
+//=    - Input:  String (the key ends at the first white space)             =
+//=    - Output: Returns the hash                                           =
+//===========================================================================
+uint64_t fnv1a(char *s)
+{
+    uint64_t h;                     // Hash value
+
+    h = 0xcbf29ce484222325ULL;
+    for ( ; (*s != '\0') && (*s != ' ') && (*s != '\t') && (*s != '\n') &&
+          (*s != '\r'); s++)
+        h = (h ^ (unsigned char) *s) * 0x100000001b3ULL;
+
+    return(h);
+}
+
+//===========================================================================
+//=  Function to compare counts for a descending qsort()                    =
+//===========================================================================
+int cmp_desc(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return((x < y) ? 1 : ((x > y) ? -1 : 0));
+}
+
+//===========================================================================
+//=  Function to find the maximum likelihood alpha for ranks 1 to k         =
+//=    - Input:  Counts in rank order and number of ranks                   =
+//=    - Output: Returns alpha (0 to FZ_ALPHA_MAX)                          =
+//=    - Solves E[ln i] = (sum of f[i] ln i) / (sum of f[i]) for a Zipf on  =
+//=      1 to k.  E[ln i] falls with alpha at a slope of -Var[ln i], so     =
+//=      Newton steps are used and a bisection step is taken whenever a     =
+//=      step would leave the bracket.                                      =
+//===========================================================================
+double zipf_fit(uint64_t *f, long k)
+{
+    double   *lnr;                  // ln(i) for each rank
+    double   sf, sfl;               // Sum of f and of f ln(i)
+    double   target;                // Trace mean of ln(i)
+    double   h, hl, hll;            // Sums of i^-a, i^-a ln i, i^-a ln^2 i
+    double   w;                     // Term i^-a
+    double   g, dg;                 // E[ln i] - target and its slope
+    double   a, lo, hi;             // Alpha and its bracket
+    double   step;                  // Newton step
+    int      iter;                  // Iteration counter
+    long     i;                     // Loop counter
+
+    lnr = (double *) malloc(k * sizeof(double));
+    if (lnr == NULL)
+    {
+        printf("ERROR - could not malloc space for ranks \n");
+        exit(1);
+    }
+    sf = sfl = 0.0;
+    for (i = 0; i < k; i++)
+    {
+        lnr[i] = log((double) (i + 1));
+        sf = sf + (double) f[i];
+        sfl = sfl + (double) f[i] * lnr[i];
+    }
+    target = sfl / sf;
+
+    lo = 0.0;
+    hi = FZ_ALPHA_MAX;
+    a = 1.0;
+    for (iter = 0; iter < FZ_MAX_ITER; iter++)
+    {
+        h = hl = hll = 0.0;
+        #pragma omp parallel for private(w) reduction(+:h, hl, hll)
+        for (i = 0; i < k; i++)
+        {
+            w = exp(-a * lnr[i]);
+            h = h + w;
+            hl = hl + w * lnr[i];
+            hll = hll + w * lnr[i] * lnr[i];
+        }
+        g = hl / h - target;
+        dg = -(hll / h - (hl / h) * (hl / h));
+
+        // Narrow the bracket and take a Newton (or bisection) step
+        if (g > 0.0)
+            lo = a;
+        else
+            hi = a;
+        step = (dg < 0.0) ? (g / dg) : 0.0;
+        if ((dg >= 0.0) || (a - step <= lo) || (a - step >= hi))
+            step = a - 0.5 * (lo + hi);
+        a = a - step;
+        if ((fabs(step) < FZ_TOL) || (hi - lo < FZ_TOL))
+            break;
+    }
+
+    free(lnr);
+    return(a);
+}
+
+//===========================================================================
+//=  Function to sum i^-alpha for i = 1 to n                                =
+//=    - Input:  n and alpha                                                =
+//=    - Output: Returns the sum, exact for the first FZ_EXACT terms and    =
+//=      by Euler-Maclaurin (integral plus end corrections) past them       =
+//===========================================================================
+double zipf_h(double n, double alpha)
+{
+    double   sum;                   // Sum of terms
+    double   m;                     // Last exact term
+    double   i;                     // Loop counter
+
+    m = (n < FZ_EXACT) ? n : FZ_EXACT;
+    sum = 0.0;
+    for (i = m; i >= 1.0; i = i - 1.0)
+        sum = sum + pow(i, -alpha);
+    if (n <= m)
+        return(sum);
+
+    if (fabs(alpha - 1.0) < 1.0e-12)
+        sum = sum + log(n / m);
+    else
+        sum = sum + (pow(n, 1.0 - alpha) - pow(m, 1.0 - alpha)) /
+            (1.0 - alpha);
+    sum = sum + 0.5 * (pow(n, -alpha) - pow(m, -alpha));
+    sum = sum - alpha / 12.0 * (pow(n, -alpha - 1.0) - pow(m, -alpha - 1.0));
+
+    return(sum);
+}
@@ -3,6 +3,9 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Uses inversion when n * min(p, 1 - p) < 30 and otherwise     =
+//=            the BTPE method of Kachitvichyanukul and Schmeiser, so the   =
+//=            expected time per value does not grow with n                 =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -45,9 +48,17 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
+#include <math.h>               // Needed for log(), pow(), and sqrt()
+
+//----- Defines -------------------------------------------------------------
+#define BTPE_MIN_MEAN  30.0     // Smallest n * p that uses the BTPE method
+#define BIN_BLOCK      1024     // Number of values generated per batch
 
 //----- Function prototypes -------------------------------------------------
 int    binomial(double p, int n); // Returns a Binomial random variable
+void   binomial_fill(int *buf, int num, double p, int n); // Batch of rvs
+int    binomial_inv(double p, int n);  // Binomial rv using inversion
+int    binomial_btpe(double p, int n); // Binomial rv using BTPE
 double rand_val(int seed);        // Jain's RNG
 
 //===== Main program ========================================================
@@ -58,9 +69,10 @@ void main(void)
     char     temp_string[256];    // Temporary string variable
     int      n;                   // Number of trials
     double   p;                   // Probability of success
-    int      bin_rv;              // Binomial random variable
+    int      bin_rv[BIN_BLOCK];   // Batch of binomial random variables
     int      num_values;          // Number of values to generate
-    int      i;                   // Loop counter
+    int      num_block;           // Number of values in this batch
+    int      i, j;                // Loop counters
 
     // Output banner
     printf("---------------------------------------- genpois.c ----- \n");
@@ -103,10 +115,14 @@ void main(void)
     printf("-------------------------------------------------------- \n");
 
     // Generate and output binomial random variables
-    for (i = 0; i < num_values; i++)
+    for (i = 0; i < num_values; i = i + num_block)
     {
-        bin_rv = binomial(p, n);
-        fprintf(fp, "%d \n", bin_rv);
+        num_block = BIN_BLOCK;
+        if (num_block > num_values - i)
+            num_block = num_values - i;
+        binomial_fill(bin_rv, num_block, p, n);
+        for (j = 0; j < num_block; j++)
+            fprintf(fp, "%d \n", bin_rv[j]);
     }
 
     //Output message and close the output file
@@ -120,20 +136,231 @@ void main(void)
 //=  Function to generate Binomial distributed random variables             =
 //=    - Input:  p and n                                                    =
 //=    - Output: Returns with Binomial distributed random variable          =
+//=    - Works with min(p, 1 - p) and reflects the result for p > 0.5       =
 //===========================================================================
 int binomial(double p, int n)
 {
-    int    bin_value;             // Computed Poisson value to be returned
-    int    i;                     // Loop counter
+    double r;                     // min(p, 1 - p)
+    int    bin_value;             // Computed binomial value to be returned
+
+    // Handle the degenerate cases
+    if ((n <= 0) || (p <= 0.0))
+        return(0);
+    if (p >= 1.0)
+        return(n);
+
+    // Use inversion for small n * r and BTPE otherwise
+    r = (p <= 0.5) ? p : (1.0 - p);
+    if ((n * r) < BTPE_MIN_MEAN)
+        bin_value = binomial_inv(r, n);
+    else
+        bin_value = binomial_btpe(r, n);
 
-    // Generate a binomial random variate
-    bin_value = 0;
-    for (i = 0; i < n; i++)
-        if (rand_val(0) < p) bin_value++;
+    if (p > 0.5)
+        bin_value = n - bin_value;
 
     return(bin_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with Binomial distributed random variables   =
+//=    - Input:  Buffer, number of values, p, and n                         =
+//=    - Output: Fills buf[0] to buf[num - 1] with binomial rvs             =
+//=    - The setup constants of binomial_inv() and binomial_btpe() are      =
+//=      computed once for the whole batch                                  =
+//===========================================================================
+void binomial_fill(int *buf, int num, double p, int n)
+{
+    int    i;                     // Loop counter
+
+    for (i = 0; i < num; i++)
+        buf[i] = binomial(p, n);
+}
+
+//===========================================================================
+//=  Function to generate Binomial random variables using inversion         =
+//=    - Input:  p <= 0.5 and n with n * p < BTPE_MIN_MEAN                  =
+//=    - Output: Returns with Binomial distributed random variable          =
+//=    - Sequential search of the CDF using one uniform per value           =
+//===========================================================================
+int binomial_inv(double p, int n)
+{
+    static double last_p = -1.0;  // p used for the constants below
+    static int    last_n = -1;    // n used for the constants below
+    static double q_n;            // Pre-computed (1 - p)^n
+    static double s, a;           // Recurrence constants
+    static int    bound;          // Cut-off for the search
+    double z;                     // Uniform random number (0 < z < 1)
+    double prob;                  // Probability of bin_value
+    int    bin_value;             // Computed binomial value to be returned
+
+    // Recompute the constants only when p or n changes
+    if ((p != last_p) || (n != last_n))
+    {
+        s = p / (1.0 - p);
+        a = (n + 1) * s;
+        q_n = pow(1.0 - p, n);
+        bound = (int) (n * p + 10.0 * sqrt(n * p * (1.0 - p) + 1.0));
+        if (bound > n)
+            bound = n;
+        last_p = p;
+        last_n = n;
+    }
+
+    // Search the CDF using the ratio of successive probabilities
+    while (1)
+    {
+        z = rand_val(0);
+        bin_value = 0;
+        prob = q_n;
+        while ((z > prob) && (bin_value < bound))
+        {
+            z = z - prob;
+            bin_value++;
+            prob = prob * (a / bin_value - s);
+        }
+        if (z <= prob)
+            return(bin_value);
+    }
+}
+
+//===========================================================================
+//=  Function to generate Binomial random variables using the BTPE method   =
+//=  from V. Kachitvichyanukul and B. Schmeiser, "Binomial Random Variate   =
+//=  Generation," Communications of the ACM, Vol. 31, No. 2, 1988.          =
+//=    - Input:  p <= 0.5 and n with n * p >= BTPE_MIN_MEAN                 =
+//=    - Output: Returns with Binomial distributed random variable          =
+//=    - Two uniforms and no log() for most values (triangle region)        =
+//===========================================================================
+int binomial_btpe(double p, int n)
+{
+    static double last_p = -1.0;  // p used for the constants below
+    static int    last_n = -1;    // n used for the constants below
+    static double q, npq;         // 1 - p and n * p * q
+    static double fm, m;          // Mode of the distribution
+    static double p1, p2, p3, p4; // Areas of the hat function regions
+    static double xm, xl, xr;     // Center and edges of the triangle
+    static double c;              // Height of the parallelograms
+    static double laml, lamr;     // Exponential tail rates
+    double u, v;                  // Uniform random numbers
+    double x, y;                  // Candidate and candidate binomial value
+    double k;                     // Distance of y from the mode
+    double f, s, a;               // Variables for explicit evaluation
+    double rho, t, alog;          // Variables for the squeeze
+    double x1, f1, z, w;          // Variables for Stirling's formula
+    double x2, f2, z2, w2;        // Squares of the above
+    int    i;                     // Loop counter
+
+    // Recompute the constants only when p or n changes
+    if ((p != last_p) || (n != last_n))
+    {
+        q = 1.0 - p;
+        npq = n * p * q;
+        fm = n * p + p;
+        m = floor(fm);
+        p1 = floor(2.195 * sqrt(npq) - 4.6 * q) + 0.5;
+        xm = m + 0.5;
+        xl = xm - p1;
+        xr = xm + p1;
+        c = 0.134 + 20.5 / (15.3 + m);
+        a = (fm - xl) / (fm - xl * p);
+        laml = a * (1.0 + 0.5 * a);
+        a = (xr - fm) / (xr * q);
+        lamr = a * (1.0 + 0.5 * a);
+        p2 = p1 * (1.0 + 2.0 * c);
+        p3 = p2 + c / laml;
+        p4 = p3 + c / lamr;
+        last_p = p;
+        last_n = n;
+    }
+
+    while (1)
+    {
+        // Pick a region of the hat function
+        u = rand_val(0) * p4;
+        v = rand_val(0);
+        if (u <= p1)
+        {
+            // Triangle region -- accept immediately
+            return((int) floor(xm - p1 * v + u));
+        }
+        else if (u <= p2)
+        {
+            // Parallelogram region
+            x = xl + (u - p1) / c;
+            v = v * c + 1.0 - fabs(m - x + 0.5) / p1;
+            if (v > 1.0)
+                continue;
+            y = floor(x);
+        }
+        else if (u <= p3)
+        {
+            // Left exponential tail
+            y = floor(xl + log(v) / laml);
+            if (y < 0.0)
+                continue;
+            v = v * (u - p2) * laml;
+        }
+        else
+        {
+            // Right exponential tail
+            y = floor(xr - log(v) / lamr);
+            if (y > n)
+                continue;
+            v = v * (u - p3) * lamr;
+        }
+
+        // Explicit evaluation of f(y) / f(m) when y is near the mode
+        k = fabs(y - m);
+        if ((k <= 20.0) || (k >= (0.5 * npq - 1.0)))
+        {
+            s = p / q;
+            a = s * (n + 1);
+            f = 1.0;
+            if (m < y)
+                for (i = (int) m + 1; i <= (int) y; i++)
+                    f = f * (a / i - s);
+            else if (m > y)
+                for (i = (int) y + 1; i <= (int) m; i++)
+                    f = f / (a / i - s);
+            if (v <= f)
+                return((int) y);
+            continue;
+        }
+
+        // Squeeze using the normal approximation
+        rho = (k / npq) * ((k * (k / 3.0 + 0.625) + 0.1666666666666666)
+              / npq + 0.5);
+        t = -k * k / (2.0 * npq);
+        alog = log(v);
+        if (alog < (t - rho))
+            return((int) y);
+        if (alog > (t + rho))
+            continue;
+
+        // Final test using Stirling's formula for log(f(y) / f(m))
+        x1 = y + 1.0;
+        f1 = m + 1.0;
+        z = n + 1.0 - m;
+        w = n - y + 1.0;
+        x2 = x1 * x1;
+        f2 = f1 * f1;
+        z2 = z * z;
+        w2 = w * w;
+        if (alog <= (xm * log(f1 / x1) + (n - m + 0.5) * log(z / w)
+            + (y - m) * log(w * p / (x1 * q))
+            + (13860. - (462. - (132. - (99. - 140. / f2) / f2) / f2) / f2)
+              / f1 / 166320.
+            + (13860. - (462. - (132. - (99. - 140. / z2) / z2) / z2) / z2)
+              / z / 166320.
+            + (13860. - (462. - (132. - (99. - 140. / x2) / x2) / x2) / x2)
+              / x1 / 166320.
+            + (13860. - (462. - (132. - (99. - 140. / w2) / w2) / w2) / w2)
+              / w / 166320.))
+            return((int) y);
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -3,6 +3,14 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) An Erlang rv with k stages of equal rate is a gamma(k) rv    =
+//=            scaled by the stage mean, so each value costs O(1) work      =
+//=            regardless of the number of stages:                          =
+//=             * k = 1 is one exponential using inversion (one log()) or   =
+//=               the Ziggurat method of Marsaglia and Tsang (expon_zig()), =
+//=               chosen at a method prompt that is only shown for k = 1    =
+//=             * k <= ERL_PROD_MAX is -log() of a product of k uniforms    =
+//=             * Larger k uses the gamma method of Marsaglia and Tsang     =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -44,13 +52,26 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for log()
+#include <math.h>               // Needed for exp(), log(), and sqrt()
 
 //----- Constants -----------------------------------------------------------
-#define MAX_STAGES  500         // Maximum number of stages
+#define ERL_PROD_MAX  4         // Most stages for the product of uniforms
+#define EZIG_N     256          // Number of exponential Ziggurat layers
+#define EZIG_R     7.69711747013104972  // Start of the right-most tail
+#define EZIG_V     3.949659822581572e-3 // Area of each Ziggurat layer
+#define EZIG_M     2147483648.0 // 2^31 scale for unsigned 31-bit integers
+#define ZIG_N      128          // Number of normal Ziggurat layers
+#define ZIG_R      3.442619855899       // Start of the right-most tail
+#define ZIG_V      9.91256303526217e-3  // Area of each Ziggurat layer
+#define ZIG_M      1073741824.0 // 2^30 scale for signed 31-bit integers
 
 //----- Function prototypes -------------------------------------------------
 double expon(double x);         // Returns an exponential random variable
+double expon_zig(double x);     // Ziggurat exponential random variable
+double erlang(int k, double x); // Returns an Erlang random variable
+double gamma_mt(double a);      // Marsaglia-Tsang gamma(a, 1) rv for a >= 1
+double norm_zig(double mean, double std_dev);  // Ziggurat normal rv
+long   rand_bits(void);         // 31 random bits
 double rand_val(int seed);      // Jain's RNG
 
 //===== Main program ========================================================
@@ -59,12 +80,12 @@ void main(void)
     FILE     *fp;                 // File pointer to output file
     char     file_name[256];      // Output file name string
     char     temp_string[256];    // Temporary string variable
-    double   lambda[MAX_STAGES];  // Mean of rates for stages
-    double   exp_rv;              // Exponential random variable
+    double   lambda;              // Rate for each stage
     double   erl_rv;              // Erlang random variable
+    double   (*expon_rv)(double); // Exponential method (from the prompt)
     int      num_values;          // Number of values
     int      num_stages;          // Number of stages
-    int      i, j;                // Loop counters
+    int      i;                   // Loop counter
 
     // Output banner
     printf("----------------------------------------- generl.c ----- \n");
@@ -90,18 +111,26 @@ void main(void)
     printf("Number of stages ===================================> ");
     scanf("%s", temp_string);
     num_stages = atoi(temp_string);
-    if (num_stages > MAX_STAGES)
+    if (num_stages < 1)
     {
-        printf("ERROR - too many stages (max stages is %d) \n", MAX_STAGES);
+        printf("ERROR - number of stages must be at least 1 \n");
         exit(1);
     }
 
-    // Prompt for stage rate and assign the rates (lambda[])
+    // Prompt for stage rate (the same for all stages)
     printf("Rate in customers per second for stage =============> ");
     scanf("%s", temp_string);
-    lambda[0] = atof(temp_string);
-    for (i = 1; i < num_stages; i++)
-        lambda[i] = lambda[0];
+    lambda = atof(temp_string);
+
+    // Prompt for the exponential method (only used for one stage)
+    expon_rv = expon;
+    if (num_stages == 1)
+    {
+        printf("Method (1 = inversion, 2 = Ziggurat) ===============> ");
+        scanf("%s", temp_string);
+        if (atoi(temp_string) == 2)
+            expon_rv = expon_zig;
+    }
 
     // Prompt for number of values to generate
     printf("Number of values to generate =======================> ");
@@ -115,14 +144,13 @@ void main(void)
 
     // Generate and output Erlang random variables
     //  - Erlang random variable is a sum of exponential random variables
+    //    and is generated directly as a scaled gamma random variable
     for (i = 0; i < num_values; i++)
     {
-        erl_rv = 0.0;
-        for (j = 0; j < num_stages; j++)
-        {
-            exp_rv = expon(1.0 / lambda[j]);
-            erl_rv = erl_rv + exp_rv;
-        }
+        if (num_stages == 1)
+            erl_rv = expon_rv(1.0 / lambda);
+        else
+            erl_rv = erlang(num_stages, 1.0 / lambda);
         fprintf(fp, "%f \n", erl_rv);
     }
 
@@ -156,6 +184,242 @@ double expon(double x)
     return(exp_value);
 }
 
+//===========================================================================
+//=  Function to generate Erlang distributed random variables               =
+//=    - Input:  Number of stages (k >= 2) and mean value of each stage     =
+//=    - Output: Returns with Erlang distributed random variable            =
+//=    - Small k uses the sum of k exponentials as -log() of a product of   =
+//=      k uniforms (one log() in all) and large k uses gamma_mt()          =
+//===========================================================================
+double erlang(int k, double x)
+{
+    double z;                     // Product of uniform random numbers
+    int    i;                     // Loop counter
+
+    // Large k is gamma(k) scaled by the stage mean
+    if (k > ERL_PROD_MAX)
+        return(x * gamma_mt((double) k));
+
+    // Small k is a sum of exponentials (rand_val() never returns 0 or 1)
+    z = rand_val(0);
+    for (i = 1; i < k; i++)
+        z = z * rand_val(0);
+
+    return(-x * log(z));
+}
+
+//===========================================================================
+//=  Function to generate gamma(a, 1) distributed random variables for      =
+//=  a >= 1 using the method from G. Marsaglia and W. Tsang, "A Simple      =
+//=  Method for Generating Gamma Variables," ACM Transactions on            =
+//=  Mathematical Software, Vol. 26, No. 3, 2000.                           =
+//=    - Input:  Shape parameter a (a >= 1)                                 =
+//=    - Output: Returns with gamma distributed random variable             =
+//=    - Costs about one normal and one uniform per value and the squeeze   =
+//=      avoids the log() test for almost all values.  The setup constants  =
+//=      are recomputed only when a changes.                                =
+//===========================================================================
+double gamma_mt(double a)
+{
+    static double last_a = -1.0;  // Shape parameter of the last call
+    static double d, c;           // Setup constants for a
+    double   x, v, u;             // Normal, cubed variable, and uniform
+
+    // Compute the setup constants only when a changes
+    if (a != last_a)
+    {
+        d = a - 1.0 / 3.0;
+        c = 1.0 / sqrt(9.0 * d);
+        last_a = a;
+    }
+
+    while (1)
+    {
+        // Generate v = (1 + c * x)^3 with v > 0
+        do
+        {
+            x = norm_zig(0.0, 1.0);
+            v = 1.0 + c * x;
+        }
+        while (v <= 0.0);
+        v = v * v * v;
+        u = rand_val(0);
+
+        // Squeeze test and then the full test
+        if (u < 1.0 - 0.0331 * (x * x) * (x * x))
+            return(d * v);
+        if (log(u) < 0.5 * x * x + d * (1.0 - v + log(v)))
+            return(d * v);
+    }
+}
+
+//===========================================================================
+//=  Function to generate exponentially distributed random variables using  =
+//=  the Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat      =
+//=  Method for Generating Random Variables," Journal of Statistical        =
+//=  Software, Vol. 5, No. 8, 2000.                                         =
+//=    - Input:  Mean value of distribution                                 =
+//=    - Output: Returns with exponentially distributed random variable     =
+//=    - About 98% of samples need one uniform and one table compare (no    =
+//=      log()).  The layer tables are built on the first call only.        =
+//===========================================================================
+double expon_zig(double x)
+{
+    static int    first = 1;        // Static first time flag
+    static double ke[EZIG_N];       // Fast path accept bounds for layers
+    static double we[EZIG_N];       // Layer widths scaled by 1 / 2^31
+    static double fe[EZIG_N];       // Exponential density at layer edges
+    double   de, te, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    int      iz;                    // Layer index
+    double   y;                     // Exponential(1) rv
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        de = te = EZIG_R;
+        q = EZIG_V / exp(-de);
+        ke[0] = (de / q) * EZIG_M;
+        ke[1] = 0.0;
+        we[0] = q / EZIG_M;
+        we[EZIG_N - 1] = de / EZIG_M;
+        fe[0] = 1.0;
+        fe[EZIG_N - 1] = exp(-de);
+        for (i = EZIG_N - 2; i >= 1; i--)
+        {
+            de = -log(EZIG_V / de + exp(-de));
+            ke[i + 1] = (de / te) * EZIG_M;
+            te = de;
+            fe[i] = exp(-de);
+            we[i] = de / EZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (EZIG_N - 1));
+    if (jz < ke[iz])
+        return(jz * we[iz] * x);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        if (iz == 0)
+        {
+            y = EZIG_R - log(rand_val(0));
+            break;
+        }
+        y = jz * we[iz];
+        if ((fe[iz] + rand_val(0) * (fe[iz - 1] - fe[iz])) < exp(-y))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (EZIG_N - 1));
+        if (jz < ke[iz])
+        {
+            y = jz * we[iz];
+            break;
+        }
+    }
+
+    return(y * x);
+}
+
+//===========================================================================
+//=  Function to generate normally distributed random variable using the    =
+//=  Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat Method   =
+//=  for Generating Random Variables," Journal of Statistical Software,     =
+//=  Vol. 5, No. 8, 2000.                                                   =
+//=    - Input: mean and standard deviation                                 =
+//=    - Output: Returns with normally distributed random variable          =
+//=    - The layer tables are built on the first call only                  =
+//===========================================================================
+double norm_zig(double mean, double std_dev)
+{
+    static int    first = 1;        // Static first time flag
+    static double kn[ZIG_N];        // Fast path accept bounds for layers
+    static double wn[ZIG_N];        // Layer widths scaled by 1 / 2^30
+    static double fn[ZIG_N];        // Normal density at the layer edges
+    double   dn, tn, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    long     hz;                    // Signed 31-bit random integer
+    int      iz;                    // Layer index
+    double   x, y;                  // Normal(0, 1) rv and tail variable
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        dn = tn = ZIG_R;
+        q = ZIG_V / exp(-0.5 * dn * dn);
+        kn[0] = (dn / q) * ZIG_M;
+        kn[1] = 0.0;
+        wn[0] = q / ZIG_M;
+        wn[ZIG_N - 1] = dn / ZIG_M;
+        fn[0] = 1.0;
+        fn[ZIG_N - 1] = exp(-0.5 * dn * dn);
+        for (i = ZIG_N - 2; i >= 1; i--)
+        {
+            dn = sqrt(-2.0 * log(ZIG_V / dn + exp(-0.5 * dn * dn)));
+            kn[i + 1] = (dn / tn) * ZIG_M;
+            tn = dn;
+            fn[i] = exp(-0.5 * dn * dn);
+            wn[i] = dn / ZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (ZIG_N - 1));
+    hz = jz - (long) ZIG_M;
+    if (labs(hz) < kn[iz])
+        return((hz * wn[iz] * std_dev) + mean);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        x = hz * wn[iz];
+        if (iz == 0)
+        {
+            do
+            {
+                x = -log(rand_val(0)) / ZIG_R;
+                y = -log(rand_val(0));
+            }
+            while ((y + y) < (x * x));
+            x = (hz > 0) ? (ZIG_R + x) : (-ZIG_R - x);
+            break;
+        }
+        if ((fn[iz] + rand_val(0) * (fn[iz - 1] - fn[iz])) < exp(-0.5 * x * x))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (ZIG_N - 1));
+        hz = jz - (long) ZIG_M;
+        if (labs(hz) < kn[iz])
+        {
+            x = hz * wn[iz];
+            break;
+        }
+    }
+
+    // Adjust x value for specified mean and variance
+    return((x * std_dev) + mean);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -3,6 +3,14 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Optionally outputs the number of arrivals in each of a user  =
+//=            specified number of time bins.  Counts are drawn directly    =
+//=            as Poisson random variables (as in genpois.c) so that work   =
+//=            scales with the number of bins and not with arrivals.        =
+//=         4) Interarrival times are generated in batches with             =
+//=            expon_fill(), which uses an in-line polynomial log() that    =
+//=            vectorizes, or optionally one at a time with the Ziggurat    =
+//=            method of Marsaglia and Tsang (expon_zig())                  =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -12,6 +20,8 @@
 //=   Output file name ===================================> output.dat      =
 //=   Random number seed =================================> 1               =
 //=   Rate parameter (lambda) ============================> 10.0            =
+//=   Output (1 = interarrivals, 2 = counts per bin) =====> 1               =
+//=   Method (1 = batch inversion, 2 = Ziggurat) =========> 1               =
 //=   Number of values to generate =======================> 5               =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
@@ -45,10 +55,28 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>            // Needed for printf()
 #include <stdlib.h>           // Needed for exit() and ato*()
-#include <math.h>             // Needed for log()
+#include <string.h>           // Needed for memcpy()
+#include <math.h>             // Needed for exp(), log(), and floor()
+
+//----- Defines -------------------------------------------------------------
+#define PTRS_MIN_MEAN  10.0   // Smallest mean that uses the PTRS method
+#define EXP_BLOCK      1024   // Number of values generated per batch
+#define LN2_D      0.693147180559945309 // Natural log of 2
+#define EZIG_N     256          // Number of exponential Ziggurat layers
+#define EZIG_R     7.69711747013104972  // Start of the right-most tail
+#define EZIG_V     3.949659822581572e-3 // Area of each Ziggurat layer
+#define EZIG_M     2147483648.0 // 2^31 scale for unsigned 31-bit integers
 
 //----- Function prototypes -------------------------------------------------
 double expon(double x);       // Returns an exponential random variable
+void   expon_fill(double *buf, int num, double x);  // Batch of exponentials
+double expon_zig(double x);   // Ziggurat exponential random variable
+static double poly_log(double x);  // Polynomial log() (static so that
+                                   // it inlines in expon_fill())
+int    poisson(double x);     // Returns a Poisson random variable
+int    poisson_inv(double mu);  // Poisson rv using inversion
+int    poisson_ptrs(double mu); // Poisson rv using PTRS
+long   rand_bits(void);       // 31 random bits
 double rand_val(int seed);    // Jain's RNG
 
 //===== Main program ========================================================
@@ -57,9 +85,15 @@ void main(void)
     char   in_string[256];      // Input string
     FILE   *fp;                 // File pointer to output file
     double lambda;              // Mean rate
-    double exp_rv;              // Exponential random variable
-    int    num_values;          // Number of values
-    int    i;                   // Loop counter
+    double mean;                // Mean interarrival time (1 / lambda)
+    double exp_value;           // One Ziggurat exponential random variable
+    double exp_rv[EXP_BLOCK];   // Batch of exponential random variables
+    double bin_width;           // Width of a time bin in seconds
+    int    output_mode;         // 1 = interarrivals, 2 = counts per bin
+    int    method;              // 1 = batch inversion, 2 = Ziggurat
+    int    num_values;          // Number of values (or bins)
+    int    num_block;           // Number of values in this batch
+    int    i, j;                // Loop counters
 
     // Output banner
     printf("----------------------------------------- genexp.c ----- \n");
@@ -86,21 +120,67 @@ void main(void)
     scanf("%s", in_string);
     lambda = atof(in_string);
 
-    // Prompt for number of values to generate
-    printf("Number of values to generate =======================> ");
+    // Prompt for output mode
+    printf("Output (1 = interarrivals, 2 = counts per bin) =====> ");
     scanf("%s", in_string);
-    num_values = atoi(in_string);
+    output_mode = atoi(in_string);
+
+    // Prompt for number of values (or bin width and number of bins)
+    if (output_mode == 2)
+    {
+        printf("Bin width in seconds ===============================> ");
+        scanf("%s", in_string);
+        bin_width = atof(in_string);
+        if (bin_width <= 0.0)
+        {
+            printf("ERROR - bin width must be greater than 0 \n");
+            exit(1);
+        }
+        printf("Number of bins =====================================> ");
+        scanf("%s", in_string);
+        num_values = atoi(in_string);
+    }
+    else
+    {
+        printf("Method (1 = batch inversion, 2 = Ziggurat) =========> ");
+        scanf("%s", in_string);
+        method = atoi(in_string);
+        printf("Number of values to generate =======================> ");
+        scanf("%s", in_string);
+        num_values = atoi(in_string);
+    }
 
     // Output message and generate interarrival times
     printf("-------------------------------------------------------- \n");
     printf("-  Generating samples to file                          - \n");
     printf("-------------------------------------------------------- \n");
 
+    // The mean is the only constant that the exponential kernels need, so
+    // it is computed once here rather than kept in a sampler struct
+    mean = 1.0 / lambda;
+
+    // Generate and output Poisson counts per bin
+    //  - The mean count per bin is lambda * bin_width
+    if (output_mode == 2)
+    {
+        for (i = 0; i < num_values; i++)
+            fprintf(fp, "%d \n", poisson(1.0 / (lambda * bin_width)));
+    }
+
     // Generate and output exponential random variables
-    for (i = 0; i < num_values; i++)
+    else if (method == 2) for (i = 0; i < num_values; i++)
+    {
+        exp_value = expon_zig(mean);
+        fprintf(fp, "%f \n", exp_value);
+    }
+    else for (i = 0; i < num_values; i = i + num_block)
     {
-        exp_rv = expon(1.0 / lambda);
-        fprintf(fp, "%f \n", exp_rv);
+        num_block = EXP_BLOCK;
+        if (num_block > num_values - i)
+            num_block = num_values - i;
+        expon_fill(exp_rv, num_block, mean);
+        for (j = 0; j < num_block; j++)
+            fprintf(fp, "%f \n", exp_rv[j]);
     }
 
     // Output message and close the output file
@@ -133,6 +213,246 @@ double expon(double x)
     return(exp_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with exponentially distributed random        =
+//=  variables                                                              =
+//=    - Input:  Buffer, number of values, and mean value of distribution   =
+//=    - Output: Fills buf[0] to buf[num - 1] with exponential rvs          =
+//=    - Uniforms are pulled in the same order as expon() (rand_val() never =
+//=      returns 0 or 1) and then transformed in a loop that the compiler   =
+//=      can vectorize (e.g., gcc -O3 -mavx2)                               =
+//===========================================================================
+void expon_fill(double *buf, int num, double x)
+{
+    int    i;                     // Loop counter
+
+    // Pull the uniform random numbers (0 < z < 1)
+    for (i = 0; i < num; i++)
+        buf[i] = rand_val(0);
+
+    // Compute exponential random variables using inversion method
+    for (i = 0; i < num; i++)
+        buf[i] = -x * poly_log(buf[i]);
+}
+
+//===========================================================================
+//=  Function to generate exponentially distributed random variables using  =
+//=  the Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat      =
+//=  Method for Generating Random Variables," Journal of Statistical        =
+//=  Software, Vol. 5, No. 8, 2000.                                         =
+//=    - Input:  Mean value of distribution                                 =
+//=    - Output: Returns with exponentially distributed random variable     =
+//=    - About 98% of samples need one uniform and one table compare (no    =
+//=      log()).  The layer tables are built on the first call only.        =
+//===========================================================================
+double expon_zig(double x)
+{
+    static int    first = 1;        // Static first time flag
+    static double ke[EZIG_N];       // Fast path accept bounds for layers
+    static double we[EZIG_N];       // Layer widths scaled by 1 / 2^31
+    static double fe[EZIG_N];       // Exponential density at layer edges
+    double   de, te, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    int      iz;                    // Layer index
+    double   y;                     // Exponential(1) rv
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        de = te = EZIG_R;
+        q = EZIG_V / exp(-de);
+        ke[0] = (de / q) * EZIG_M;
+        ke[1] = 0.0;
+        we[0] = q / EZIG_M;
+        we[EZIG_N - 1] = de / EZIG_M;
+        fe[0] = 1.0;
+        fe[EZIG_N - 1] = exp(-de);
+        for (i = EZIG_N - 2; i >= 1; i--)
+        {
+            de = -log(EZIG_V / de + exp(-de));
+            ke[i + 1] = (de / te) * EZIG_M;
+            te = de;
+            fe[i] = exp(-de);
+            we[i] = de / EZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (EZIG_N - 1));
+    if (jz < ke[iz])
+        return(jz * we[iz] * x);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        if (iz == 0)
+        {
+            y = EZIG_R - log(rand_val(0));
+            break;
+        }
+        y = jz * we[iz];
+        if ((fe[iz] + rand_val(0) * (fe[iz - 1] - fe[iz])) < exp(-y))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (EZIG_N - 1));
+        if (jz < ke[iz])
+        {
+            y = jz * we[iz];
+            break;
+        }
+    }
+
+    return(y * x);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
+//===========================================================================
+//=  Function to compute log(x) for x > 0 without calling libm              =
+//=    - Splits x into 2^e * m with sqrt(1/2) <= m < sqrt(2) and then uses  =
+//=      log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172      =
+//=    - Accurate to within a few ulps for normal (non-denormal) x          =
+//===========================================================================
+static double poly_log(double x)
+{
+    unsigned long long bits;      // Bits of x
+    unsigned long long k;         // Biased exponent of x / sqrt(1/2)
+    unsigned long long ebits;     // Bits of 2^52 plus k
+    double    e, m, s, s2;        // Exponent, mantissa, and atanh variables
+
+    // Split x into 2^e * m with integer operations only (no compares and
+    // no integer to double conversion so that loops vectorize)
+    memcpy(&bits, &x, sizeof(bits));
+    k = (bits - 0x3fe6a09e667f3bcdULL + 0x4000000000000000ULL) >> 52;
+    ebits = k | 0x4330000000000000ULL;
+    memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1024.0);
+    bits = bits - (k << 52) + 0x4000000000000000ULL;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Series for atanh(s) up to the s^17 term
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    return((e * LN2_D) + 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5
+        + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 * (1.0 / 11 + s2 * (1.0 / 13
+        + s2 * (1.0 / 15 + s2 * (1.0 / 17))))))))));
+}
+
+//===========================================================================
+//=  Function to generate Poisson distributed random variables              =
+//=    - Input:  Mean interarrival time (the Poisson mean is 1 / x)         =
+//=    - Output: Returns with Poisson distributed random variable           =
+//===========================================================================
+int poisson(double x)
+{
+    double mu;                    // Mean of the Poisson distribution
+
+    // Use inversion for small means and PTRS for large means
+    mu = 1.0 / x;
+    if (mu < PTRS_MIN_MEAN)
+        return(poisson_inv(mu));
+    else
+        return(poisson_ptrs(mu));
+}
+
+//===========================================================================
+//=  Function to generate Poisson random variables using inversion          =
+//=    - Input:  Mean of distribution (mu < PTRS_MIN_MEAN)                  =
+//=    - Output: Returns with Poisson distributed random variable           =
+//=    - Sequential search of the CDF using one uniform per value           =
+//===========================================================================
+int poisson_inv(double mu)
+{
+    static double last_mu = -1.0; // Mean used for exp_mu
+    static double exp_mu;         // Pre-computed exp(-mu)
+    double z;                     // Uniform random number (0 < z < 1)
+    double p;                     // Probability of poi_value
+    double sum_p;                 // Cumulative probability up to poi_value
+    int    poi_value;             // Computed Poisson value to be returned
+
+    // Recompute exp(-mu) only when the mean changes
+    if (mu != last_mu)
+    {
+        exp_mu = exp(-mu);
+        last_mu = mu;
+    }
+
+    // Search the CDF for the first value with sum_p >= z
+    z = rand_val(0);
+    poi_value = 0;
+    p = exp_mu;
+    sum_p = p;
+    while (z > sum_p)
+    {
+        poi_value++;
+        p = p * mu / poi_value;
+        sum_p = sum_p + p;
+    }
+
+    return(poi_value);
+}
+
+//===========================================================================
+//=  Function to generate Poisson random variables using the PTRS method    =
+//=  from W. Hormann, "The Transformed Rejection Method for Generating      =
+//=  Poisson Random Variables," Insurance: Mathematics and Economics,       =
+//=  Vol. 12, No. 1, 1993.                                                  =
+//=    - Input:  Mean of distribution (mu >= PTRS_MIN_MEAN)                 =
+//=    - Output: Returns with Poisson distributed random variable           =
+//=    - Uses about 2.3 uniforms per value and no log() for most values     =
+//===========================================================================
+int poisson_ptrs(double mu)
+{
+    static double last_mu = -1.0; // Mean used for the constants below
+    static double a, b;           // Hat function constants
+    static double inv_alpha;      // Hat function scale
+    static double v_r;            // Bound of the fast accept region
+    static double log_mu;         // Pre-computed log(mu)
+    static double log_inv_alpha;  // Pre-computed log(inv_alpha)
+    double u, v;                  // Uniform random numbers
+    double us;                    // Distance of u from the edges
+    double k;                     // Candidate Poisson value
+
+    // Recompute the constants only when the mean changes
+    if (mu != last_mu)
+    {
+        b = 0.931 + 2.53 * sqrt(mu);
+        a = -0.059 + 0.02483 * b;
+        inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+        v_r = 0.9277 - 3.6224 / (b - 2.0);
+        log_mu = log(mu);
+        log_inv_alpha = log(inv_alpha);
+        last_mu = mu;
+    }
+
+    // Transformed rejection with squeeze
+    while (1)
+    {
+        u = rand_val(0) - 0.5;
+        v = rand_val(0);
+        us = 0.5 - fabs(u);
+        k = floor((2.0 * a / us + b) * u + mu + 0.43);
+        if ((us >= 0.07) && (v <= v_r))
+            return((int) k);
+        if ((k < 0.0) || ((us < 0.013) && (v > us)))
+            continue;
+        if ((log(v) + log_inv_alpha - log(a / (us * us) + b))
+            <= (-mu + k * log_mu - lgamma(k + 1.0)))
+            return((int) k);
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -4,6 +4,10 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Optionally outputs the indices (1, 2, ...) of the successes  =
+//=            in a user specified number of Bernoulli(p) trials by jumping =
+//=            from one success to the next with geometric gaps, so work    =
+//=            scales with the number of successes and not with trials      =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -13,6 +17,7 @@
 //=   Output file name ===================================> x.txt           =
 //=   Random number seed (greater than 0) ================> 1               =
 //=   Probability of success (0 < p < 1) =================> 0.25            =
+//=   Output (1 = values, 2 = success indices) ===========> 1               =
 //=   Number of values to generate =======================> 5               =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
@@ -44,10 +49,21 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>            // Needed for printf()
 #include <stdlib.h>           // Needed for exit() and ato*()
-#include <math.h>             // Needed for log()
+#include <math.h>             // Needed for log(), log1p(), and floor()
+
+//----- Defines -------------------------------------------------------------
+#define GEO_BLOCK  1024       // Number of values generated per batch
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                // Geometric sampler built by geo_init()
+{
+    double inv_log;           // 1 / log(1 - p)
+} geo_t;
 
 //----- Function prototypes -------------------------------------------------
-int geo(double p);            // Returns a geometric random variable
+void geo_init(geo_t *s, double p);  // Builds a geometric sampler
+long long geo_sample(geo_t *s);  // Returns a geometric random variable
+void geo_fill(geo_t *s, long long *buf, int num);  // Batch of geometric rvs
 double rand_val(int seed);    // Jain's RNG
 
 //===== Main program ========================================================
@@ -56,9 +72,14 @@ void main(void)
     char   in_string[256];      // Input string
     FILE   *fp;                 // File pointer to output file
     double p;                   // Probability of success for geometric
-    int    geo_rv;              // Geometric random variable
+    geo_t  sampler;             // Geometric sampler
+    long long geo_rv[GEO_BLOCK];  // Batch of geometric random variables
     int    num_values;          // Number of values
-    int    i;                   // Loop counter
+    int    output_mode;         // 1 = values, 2 = success indices
+    long long num_trials;       // Number of trials for success indices
+    long long index;            // Index of the current success
+    int    num_block;           // Number of values in this batch
+    int    i, j;                // Loop counters
 
     // Output banner
     printf("----------------------------------------- gengeo.c ----- \n");
@@ -84,22 +105,65 @@ void main(void)
     printf("Probability of success (0 < p < 1) =================> ");
     scanf("%s", in_string);
     p = atof(in_string);
+    if ((p <= 0.0) || (p >= 1.0))
+    {
+        printf("ERROR - probability of success must be 0 < p < 1 \n");
+        exit(1);
+    }
 
-    // Prompt for number of values to generate
-    printf("Number of values to generate =======================> ");
+    // Prompt for output mode
+    printf("Output (1 = values, 2 = success indices) ===========> ");
     scanf("%s", in_string);
-    num_values = atoi(in_string);
+    output_mode = atoi(in_string);
+
+    // Prompt for number of trials or number of values to generate
+    if (output_mode == 2)
+    {
+        printf("Number of trials ===================================> ");
+        scanf("%s", in_string);
+        num_trials = atoll(in_string);
+    }
+    else
+    {
+        printf("Number of values to generate =======================> ");
+        scanf("%s", in_string);
+        num_values = atoi(in_string);
+    }
 
     // Output message and generate interarrival times
     printf("-------------------------------------------------------- \n");
     printf("-  Generating samples to file                          - \n");
     printf("-------------------------------------------------------- \n");
 
+    // Build the sampler once
+    geo_init(&sampler, p);
+
+    // Generate and output success indices
+    //  - The gap to the next success is a geometric random variable
+    if (output_mode == 2)
+    {
+        index = 0;
+        while (index <= num_trials)
+        {
+            geo_fill(&sampler, geo_rv, GEO_BLOCK);
+            for (i = 0; i < GEO_BLOCK; i++)
+            {
+                index = index + geo_rv[i];
+                if (index > num_trials) break;
+                fprintf(fp, "%lld \n", index);
+            }
+        }
+    }
+
     // Generate and output geometric random variables
-    for (i = 0; i < num_values; i++)
+    else for (i = 0; i < num_values; i = i + num_block)
     {
-        geo_rv = geo(p);
-        fprintf(fp, "%d \n", geo_rv);
+        num_block = GEO_BLOCK;
+        if (num_block > num_values - i)
+            num_block = num_values - i;
+        geo_fill(&sampler, geo_rv, num_block);
+        for (j = 0; j < num_block; j++)
+            fprintf(fp, "%lld \n", geo_rv[j]);
     }
 
     // Output message and close the output file
@@ -109,12 +173,24 @@ void main(void)
     fclose(fp);
 }
 
+//===========================================================================
+//=  Function to build a geometric sampler                                  =
+//=    - Input:  Sampler and probability of success p                       =
+//=    - Output: Fills in the constants of the sampler                      =
+//=    - Uses log1p(-p) since 1 - p loses the digits of a small p           =
+//===========================================================================
+void geo_init(geo_t *s, double p)
+{
+    s->inv_log = 1.0 / log1p(-p);
+}
+
 //===========================================================================
 //=  Function to generate geometrically distributed random variables        =
-//=    - Input:  Probability of success p                                   =
+//=    - Input:  Sampler from geo_init()                                    =
 //=    - Output: Returns with geometrically distributed random variable     =
+//=      (64-bit, since gaps for a small p do not fit in an int)            =
 //===========================================================================
-int geo(double p)
+long long geo_sample(geo_t *s)
 {
     double z;                     // Uniform random number (0 < z < 1)
     double geo_value;             // Computed geometric value to be returned
@@ -127,9 +203,23 @@ int geo(double p)
     while ((z == 0) || (z == 1));
 
     // Compute geometric random variable using inversion method
-    geo_value = (int) (log(z) / log(1.0 - p)) + 1;
+    geo_value = floor(log(z) * s->inv_log) + 1.0;
+
+    return((long long) geo_value);
+}
+
+//===========================================================================
+//=  Function to fill a buffer with geometrically distributed random        =
+//=  variables                                                              =
+//=    - Input:  Sampler from geo_init(), buffer, and number of values      =
+//=    - Output: Fills buf[0] to buf[num - 1] with geometric rvs            =
+//===========================================================================
+void geo_fill(geo_t *s, long long *buf, int num)
+{
+    int    i;                     // Loop counter
 
-    return(geo_value);
+    for (i = 0; i < num; i++)
+        buf[i] = geo_sample(s);
 }
 
 //=========================================================================
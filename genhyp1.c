@@ -6,6 +6,12 @@
 //=             * File format is <interarrival time delta>                  =
 //=         2) Takes as input the Lambda1, Lambda2, P1, and P2              =
 //=         3) Generates samples for user specified time period             =
+//=         4) Optionally outputs the number of arrivals in each time bin   =
+//=             * H2 arrivals are a renewal process (not a modulated        =
+//=               Poisson process) so arrivals are still drawn, but only    =
+//=               one count per bin is written to the file                  =
+//=         5) Exponential times use inversion (one log() each) or the      =
+//=            Ziggurat method of Marsaglia and Tsang (expon_zig())         =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -19,6 +25,8 @@
 //=   Arrival rate in customers per second (lambda2) =====> 1.0             =
 //=   Probability for state 1 ============================> 0.25            =
 //=   Time period to generate interarrival times =========> 10.0            =
+//=   Output (1 = interarrivals, 2 = counts per bin) =====> 1               =
+//=   Method (1 = inversion, 2 = Ziggurat) ===============> 1               =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
 //=   --------------------------------------------------------              =
@@ -53,10 +61,18 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for log()
+#include <math.h>               // Needed for exp() and log()
+
+//----- Defines -------------------------------------------------------------
+#define EZIG_N     256          // Number of exponential Ziggurat layers
+#define EZIG_R     7.69711747013104972  // Start of the right-most tail
+#define EZIG_V     3.949659822581572e-3 // Area of each Ziggurat layer
+#define EZIG_M     2147483648.0 // 2^31 scale for unsigned 31-bit integers
 
 //----- Function prototypes -------------------------------------------------
 double expon(double x);         // Returns an exponential random variable
+double expon_zig(double x);     // Ziggurat exponential random variable
+long   rand_bits(void);         // 31 random bits
 double rand_val(int seed);      // Jain's RNG
 
 //===== Main program ========================================================
@@ -69,8 +85,13 @@ void main(void)
     double   lambda2;             // Mean of arrival rate for state 2
     double   p1;                  // Probability goto state 1
     double   hyp_rv;              // Hyperxponential random variable
+    double   (*expon_rv)(double); // Exponential method (from the prompt)
     double   time_period;         // Time period to generate arrival samples
     double   sum_time;            // Sum of time up to now
+    double   bin_width;           // Width of a time bin in seconds
+    double   bin_start;           // Start time of the current bin
+    int      output_mode;         // 1 = interarrivals, 2 = counts per bin
+    int      count;               // Number of arrivals in a bin
     int      i;                   // Loop counter
 
     // Output banner
@@ -114,19 +135,67 @@ void main(void)
     scanf("%s", temp_string);
     time_period = atof(temp_string);
 
+    // Prompt for output mode (and bin width for counts per bin)
+    printf("Output (1 = interarrivals, 2 = counts per bin) =====> ");
+    scanf("%s", temp_string);
+    output_mode = atoi(temp_string);
+    if (output_mode == 2)
+    {
+        printf("Bin width in seconds ===============================> ");
+        scanf("%s", temp_string);
+        bin_width = atof(temp_string);
+        if (bin_width <= 0.0)
+        {
+            printf("ERROR - bin width must be greater than 0 \n");
+            exit(1);
+        }
+    }
+
+    // Prompt for the exponential method
+    printf("Method (1 = inversion, 2 = Ziggurat) ===============> ");
+    scanf("%s", temp_string);
+    if (atoi(temp_string) == 2)
+        expon_rv = expon_zig;
+    else
+        expon_rv = expon;
+
     //Output message and generate interarrival times
     printf("-------------------------------------------------------- \n");
     printf("-  Generating samples to file                          - \n");
     printf("-------------------------------------------------------- \n");
 
-    // Generate and output interarrival times
+    // Generate and output arrival counts per bin
+    //  - sum_time is the time of the next arrival
     sum_time = 0.0;
-    while(1)
+    if (output_mode == 2)
     {
         if (rand_val(0) <= p1)
-            hyp_rv = expon(1.0 / lambda1);
+            sum_time = expon_rv(1.0 / lambda1);
         else
-            hyp_rv = expon(1.0 / lambda2);
+            sum_time = expon_rv(1.0 / lambda2);
+        for (bin_start = 0.0; bin_start < time_period;
+             bin_start = bin_start + bin_width)
+        {
+            count = 0;
+            while (sum_time < (bin_start + bin_width))
+            {
+                count++;
+                if (rand_val(0) <= p1)
+                    sum_time = sum_time + expon_rv(1.0 / lambda1);
+                else
+                    sum_time = sum_time + expon_rv(1.0 / lambda2);
+            }
+            fprintf(fp, "%d \n", count);
+        }
+    }
+
+    // Generate and output interarrival times
+    else while(1)
+    {
+        if (rand_val(0) <= p1)
+            hyp_rv = expon_rv(1.0 / lambda1);
+        else
+            hyp_rv = expon_rv(1.0 / lambda2);
         fprintf(fp, "%f \n", hyp_rv);
         sum_time = sum_time + hyp_rv;
         if (sum_time >= time_period) break;
@@ -158,6 +227,89 @@ double expon(double x)
     return(-x * log(z));
 }
 
+//===========================================================================
+//=  Function to generate exponentially distributed random variables using  =
+//=  the Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat      =
+//=  Method for Generating Random Variables," Journal of Statistical        =
+//=  Software, Vol. 5, No. 8, 2000.                                         =
+//=    - Input:  Mean value of distribution                                 =
+//=    - Output: Returns with exponentially distributed random variable     =
+//=    - About 98% of samples need one uniform and one table compare (no    =
+//=      log()).  The layer tables are built on the first call only.        =
+//===========================================================================
+double expon_zig(double x)
+{
+    static int    first = 1;        // Static first time flag
+    static double ke[EZIG_N];       // Fast path accept bounds for layers
+    static double we[EZIG_N];       // Layer widths scaled by 1 / 2^31
+    static double fe[EZIG_N];       // Exponential density at layer edges
+    double   de, te, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    int      iz;                    // Layer index
+    double   y;                     // Exponential(1) rv
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        de = te = EZIG_R;
+        q = EZIG_V / exp(-de);
+        ke[0] = (de / q) * EZIG_M;
+        ke[1] = 0.0;
+        we[0] = q / EZIG_M;
+        we[EZIG_N - 1] = de / EZIG_M;
+        fe[0] = 1.0;
+        fe[EZIG_N - 1] = exp(-de);
+        for (i = EZIG_N - 2; i >= 1; i--)
+        {
+            de = -log(EZIG_V / de + exp(-de));
+            ke[i + 1] = (de / te) * EZIG_M;
+            te = de;
+            fe[i] = exp(-de);
+            we[i] = de / EZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (EZIG_N - 1));
+    if (jz < ke[iz])
+        return(jz * we[iz] * x);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        if (iz == 0)
+        {
+            y = EZIG_R - log(rand_val(0));
+            break;
+        }
+        y = jz * we[iz];
+        if ((fe[iz] + rand_val(0) * (fe[iz - 1] - fe[iz])) < exp(-y))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (EZIG_N - 1));
+        if (jz < ke[iz])
+        {
+            y = jz * we[iz];
+            break;
+        }
+    }
+
+    return(y * x);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -6,6 +6,19 @@
 //=             * File format is <interarrival time delta>                  =
 //=         2) Takes as input the mean arrival rate and the CoV             =
 //=         3) Generates samples for user specified time period             =
+//=         4) The hyperexponential is fit once by one of                   =
+//=             * Morse's method (balanced means) from the mean and CoV     =
+//=             * An exact H2 match of the first three moments, given the   =
+//=               mean, CoV, and normalized third moment E[X^3] / E[X]^3    =
+//=               (needs E[X^3] / E[X]^3 > 1.5 * (1 + CoV^2)^2)             =
+//=             * An EM fit of a k-phase hyperexponential (k <= HYP_MAX_K)  =
+//=               to a trace file of values (one per line).  The E-step     =
+//=               sums are parallel with OpenMP (gcc -fopenmp) and run      =
+//=               serially otherwise.                                       =
+//=         5) Each value uses one uniform.  The phase is picked from the   =
+//=            cumulative probabilities and the position of the uniform     =
+//=            within the phase's interval is rescaled to a new uniform     =
+//=            for the exponential.                                         =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -15,11 +28,14 @@
 //=   --------------------------------------------------------              =
 //=   Output file name ===================================> output.dat      =
 //=   Random number seed =================================> 1               =
+//=   Fit (1 = Morse, 2 = three moments, 3 = EM trace) ===> 1               =
 //=   Arrival rate in customers per second (lambda) ======> 1.0             =
 //=   Desired coefficent of variation (CoV > 1) ==========> 2.0             =
-//=   Time period to generate interarrival times =========> 20.0            =
+//=   Time period to generate interarrival times =========> 60.0            =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
+//=   -    * phase 1: p = 0.112702, mean = 4.436492                         =
+//=   -    * phase 2: p = 0.887298, mean = 0.563508                         =
 //=   --------------------------------------------------------              =
 //=   --------------------------------------------------------              =
 //=   -  Done!                                                              =
@@ -27,18 +43,23 @@
 //=-------------------------------------------------------------------------=
 //= Example output file ("output.dat" for above):                           =
 //=                                                                         =
-//=   8.999251                                                              =
-//=   0.439236                                                              =
-//=   0.855896                                                              =
-//=   1.718401                                                              =
-//=   0.038058                                                              =
-//=   0.369126                                                              =
-//=   1.896041                                                              =
-//=   2.819142                                                              =
-//=   2.742466                                                              =
-//=   1.524527                                                              =
+//=   42.479411                                                             =
+//=   2.170862                                                              =
+//=   0.181555                                                              =
+//=   0.530764                                                              =
+//=   0.421375                                                              =
+//=   1.195943                                                              =
+//=   3.875931                                                              =
+//=   0.253184                                                              =
+//=   0.252754                                                              =
+//=   0.043081                                                              =
+//=   0.668771                                                              =
+//=   0.439576                                                              =
+//=   0.119094                                                              =
+//=   5.242588                                                              =
+//=   3.308646                                                              =
 //=-------------------------------------------------------------------------=
-//=  Build: bcc32 genhyp2.c                                                 =
+//=  Build: bcc32 genhyp2.c, gcc -fopenmp genhyp2.c -lm                     =
 //=-------------------------------------------------------------------------=
 //=  Execute: genhyp2                                                       =
 //=-------------------------------------------------------------------------=
@@ -55,10 +76,29 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for log()
+#include <math.h>               // Needed for log(), exp(), pow(), sqrt(),
+                                //  and fabs()
+
+//----- Defines -------------------------------------------------------------
+#define HYP_MAX_K     8         // Maximum number of phases
+#define EM_MAX_ITER   1000      // Maximum number of EM iterations
+#define EM_TOL        1.0e-9    // Relative log-likelihood change to stop
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                  // Hyperexponential sampler from hyper_init()
+{
+    int    k;                   // Number of phases
+    double cum[HYP_MAX_K];      // Cumulative phase probabilities
+    double mean[HYP_MAX_K];     // Mean of each phase
+} hyper_t;
 
 //----- Function prototypes -------------------------------------------------
-double hyper(double x, double cov);  // Returns a hyperexponential rv
+void   hyper_init(hyper_t *s, double x, double cov);  // Builds a sampler
+int    hyper_init3(hyper_t *s, double x, double cov, double n3);
+void   hyper_fit_em(hyper_t *s, double *data, long n, int k);
+void   hyper_set(hyper_t *s, int k, double *p, double *mean);
+double hyper_sample(hyper_t *s);     // Returns a hyperexponential rv
+void   hyper_fill(hyper_t *s, double *buf, int num);  // Batch of rvs
 double rand_val(int seed);           // Jain's RNG
 
 //===== Main program ========================================================
@@ -67,8 +107,16 @@ void main(void)
     FILE     *fp;                 // File pointer to output file
     char     file_name[256];      // Output file name string
     char     temp_string[256];    // Temporary string variable
+    FILE     *fp_in;              // File pointer to trace file
     double   lambda;              // Mean of arrival rate
     double   cov;                 // Coefficient of variation
+    double   n3;                  // Normalized third moment
+    int      fit;                 // 1 = Morse, 2 = three moments, 3 = EM
+    int      k;                   // Number of phases for the EM fit
+    double   *data;               // Trace values for the EM fit
+    long     num_data;            // Number of trace values
+    long     max_data;            // Size of the data[] array
+    hyper_t  sampler;             // Hyperexponential sampler
     double   hyp_rv;              // Hyperxponential random variable
     double   time_period;         // Time period to generate arrival samples
     double   sum_time;            // Sum of time up to now
@@ -95,15 +143,87 @@ void main(void)
     scanf("%s", temp_string);
     rand_val((int) atoi(temp_string));
 
-    // Prompt for mean arrival rate (lambda)
-    printf("Arrival rate in customers per second (lambda) ======> ");
+    // Prompt for the fit method
+    printf("Fit (1 = Morse, 2 = three moments, 3 = EM trace) ===> ");
     scanf("%s", temp_string);
-    lambda = atof(temp_string);
+    fit = atoi(temp_string);
 
-    // Prompt for coefficent of variation (cov)
-    printf("Desired coefficent of variation (CoV > 1) ==========> ");
-    scanf("%s", temp_string);
-    cov = atof(temp_string);
+    // Prompt for the trace file and number of phases and then fit once
+    if (fit == 3)
+    {
+        printf("Trace file name ====================================> ");
+        scanf("%s", temp_string);
+        fp_in = fopen(temp_string, "r");
+        if (fp_in == NULL)
+        {
+            printf("ERROR in opening trace file (%s) \n", temp_string);
+            exit(1);
+        }
+        printf("Number of phases (k) ===============================> ");
+        scanf("%s", temp_string);
+        k = atoi(temp_string);
+        if ((k < 1) || (k > HYP_MAX_K))
+        {
+            printf("ERROR - number of phases must be 1 to %d \n", HYP_MAX_K);
+            exit(1);
+        }
+
+        // Load the whole trace into memory
+        max_data = 1024;
+        num_data = 0;
+        data = (double *) malloc(max_data * sizeof(double));
+        while ((data != NULL) && (fscanf(fp_in, "%lf", &data[num_data]) == 1))
+        {
+            if (data[num_data] < 0.0)
+            {
+                printf("ERROR - trace value %ld is negative \n", num_data);
+                exit(1);
+            }
+            num_data++;
+            if (num_data == max_data)
+            {
+                max_data = 2 * max_data;
+                data = (double *) realloc(data, max_data * sizeof(double));
+            }
+        }
+        if (data == NULL)
+        {
+            printf("ERROR - could not malloc space for trace \n");
+            exit(1);
+        }
+        if (num_data < k)
+        {
+            printf("ERROR - trace has fewer than k values \n");
+            exit(1);
+        }
+        fclose(fp_in);
+        hyper_fit_em(&sampler, data, num_data, k);
+        free(data);
+    }
+
+    // Prompt for mean arrival rate, CoV, and third moment and then fit once
+    else
+    {
+        printf("Arrival rate in customers per second (lambda) ======> ");
+        scanf("%s", temp_string);
+        lambda = atof(temp_string);
+        printf("Desired coefficent of variation (CoV > 1) ==========> ");
+        scanf("%s", temp_string);
+        cov = atof(temp_string);
+        if (fit == 2)
+        {
+            printf("Normalized third moment E[X^3] / E[X]^3 ============> ");
+            scanf("%s", temp_string);
+            n3 = atof(temp_string);
+            if (hyper_init3(&sampler, (1.0 / lambda), cov, n3) != 0)
+            {
+                printf("ERROR - no H2 matches these three moments \n");
+                exit(1);
+            }
+        }
+        else
+            hyper_init(&sampler, (1.0 / lambda), cov);
+    }
 
     // Prompt for time period (seconds) to generate samples
     printf("Time period to generate interarrival times =========> ");
@@ -113,13 +233,17 @@ void main(void)
     //Output message and generate interarrival times
     printf("-------------------------------------------------------- \n");
     printf("-  Generating samples to file                          - \n");
+    for (i = 0; i < sampler.k; i++)
+        printf("-    * phase %d: p = %f, mean = %f \n", i + 1,
+            sampler.cum[i] - ((i == 0) ? 0.0 : sampler.cum[i - 1]),
+            sampler.mean[i]);
     printf("-------------------------------------------------------- \n");
 
     // Generate and output interarrival times
     sum_time = 0.0;
     while(1)
     {
-        hyp_rv = hyper((1.0 / lambda), cov);
+        hyp_rv = hyper_sample(&sampler);
         fprintf(fp, "%f \n", hyp_rv);
         sum_time = sum_time + hyp_rv;
         if (sum_time >= time_period) break;
@@ -133,45 +257,216 @@ void main(void)
 }
 
 //===========================================================================
-//=  Function to generate hyperexponentially distributed random variables   =
-//=  Uses Morse's method taken from SMPL from Simulating Computer Systems   =
-//=  Systems, Techniques and Tools by M. H. MacDougall (1987)               =
-//=    - Input:  Mean value of distribution and coefficient of variation    =
-//=    - Output: Returns with hyperexponentially distributed rv             =
+//=  Function to build a hyperexponential sampler using Morse's method      =
+//=  taken from SMPL from Simulating Computer Systems Systems, Techniques   =
+//=  and Tools by M. H. MacDougall (1987)                                   =
+//=    - Input:  Sampler, mean value of distribution, and coefficient of    =
+//=              variation                                                  =
+//=    - Output: Fills in the constants of the sampler                      =
 //===========================================================================
-double hyper(double x, double cov)
+void hyper_init(hyper_t *s, double x, double cov)
 {
-    double p;                     // Probability value for Morse's method
-    double z1, z2;                // Uniform random numbers from 0 to 1
-    double hyp_value;             // Computed exponential value to be returned
     double temp;                  // Temporary double value
+    double p[2], mean[2];         // Phase probabilities and means
 
-    // Pull a uniform random number (0 < z1 < 1)
-    do
+    temp = cov * cov;
+    p[0] = 0.5 * (1.0 - sqrt((temp - 1.0) / (temp + 1.0)));
+    p[1] = 1.0 - p[0];
+    mean[0] = 0.5 * x / p[0];
+    mean[1] = 0.5 * x / p[1];
+    hyper_set(s, 2, p, mean);
+}
+
+//===========================================================================
+//=  Function to build an H2 sampler that matches three moments             =
+//=    - Input:  Sampler, mean, coefficient of variation, and normalized    =
+//=              third moment n3 = E[X^3] / E[X]^3                          =
+//=    - Output: Fills in the sampler and returns 0, or returns -1 if no    =
+//=      H2 has these moments                                               =
+//=    - With r_k = E[X^k] / k! the phase means are the roots of            =
+//=      m^2 - s * m + t = 0 where s = (r3 - r1 * r2) / (r2 - r1^2) and     =
+//=      t = s * r1 - r2, and p = (r1 - m2) / (m1 - m2)                     =
+//===========================================================================
+int hyper_init3(hyper_t *s, double x, double cov, double n3)
+{
+    double r1, r2, r3;            // Reduced moments
+    double sum, prod, disc;       // Sum, product, and discriminant of means
+    double p[2], mean[2];         // Phase probabilities and means
+
+    r1 = x;
+    r2 = (1.0 + cov * cov) * x * x / 2.0;
+    r3 = n3 * x * x * x / 6.0;
+    if ((r2 <= r1 * r1) || (r1 * r3 <= r2 * r2))
+        return(-1);
+
+    sum = (r3 - r1 * r2) / (r2 - r1 * r1);
+    prod = sum * r1 - r2;
+    disc = sum * sum - 4.0 * prod;
+    if ((prod <= 0.0) || (disc <= 0.0))
+        return(-1);
+    mean[0] = 0.5 * (sum + sqrt(disc));
+    mean[1] = 0.5 * (sum - sqrt(disc));
+    p[0] = (r1 - mean[1]) / (mean[0] - mean[1]);
+    p[1] = 1.0 - p[0];
+    if ((p[0] <= 0.0) || (p[0] >= 1.0))
+        return(-1);
+
+    hyper_set(s, 2, p, mean);
+    return(0);
+}
+
+//===========================================================================
+//=  Function to fit a k-phase hyperexponential to a trace using EM         =
+//=    - Input:  Sampler, trace values, number of values, and k             =
+//=    - Output: Fills in the sampler with the fitted phases                =
+//=    - Starts from equal probabilities and means spread by factors of 4   =
+//=      around the trace mean, and stops when the log-likelihood changes   =
+//=      by less than EM_TOL (relative) or after EM_MAX_ITER iterations     =
+//=    - The E-step sums over the trace are split across OpenMP threads     =
+//===========================================================================
+void hyper_fit_em(hyper_t *s, double *data, long n, int k)
+{
+    double p[HYP_MAX_K];          // Phase probabilities
+    double mean[HYP_MAX_K];       // Phase means
+    double lw[HYP_MAX_K];         // log(p / mean) for each phase
+    double sw[HYP_MAX_K];         // Sum of responsibilities
+    double swx[HYP_MAX_K];        // Sum of responsibilities times values
+    double w[HYP_MAX_K];          // Responsibilities for one value
+    double big, tot;              // Largest log term and normalizer
+    double loglik, last_loglik;   // Log-likelihood of this and last step
+    double x_mean;                // Mean of the trace
+    int    iter;                  // Iteration counter
+    long   i;                     // Loop counter
+    int    j;                     // Loop counter
+
+    // Start from means spread around the trace mean
+    x_mean = 0.0;
+    for (i = 0; i < n; i++)
+        x_mean = x_mean + data[i];
+    x_mean = x_mean / n;
+    for (j = 0; j < k; j++)
     {
-        z1 = rand_val(0);
+        p[j] = 1.0 / k;
+        mean[j] = x_mean * pow(4.0, j - 0.5 * (k - 1));
     }
-    while ((z1 == 0) || (z1 == 1));
 
-    // Pull another uniform random number (0 < z2 < 1)
+    last_loglik = -HUGE_VAL;
+    for (iter = 0; iter < EM_MAX_ITER; iter++)
+    {
+        for (j = 0; j < k; j++)
+        {
+            lw[j] = log(p[j] / mean[j]);
+            sw[j] = swx[j] = 0.0;
+        }
+        loglik = 0.0;
+
+        // E-step -- responsibilities of each phase for each value
+        #pragma omp parallel for private(j, w, big, tot) \
+            reduction(+:loglik, sw[:HYP_MAX_K], swx[:HYP_MAX_K])
+        for (i = 0; i < n; i++)
+        {
+            big = -HUGE_VAL;
+            for (j = 0; j < k; j++)
+            {
+                w[j] = lw[j] - data[i] / mean[j];
+                if (w[j] > big)
+                    big = w[j];
+            }
+            tot = 0.0;
+            for (j = 0; j < k; j++)
+            {
+                w[j] = exp(w[j] - big);
+                tot = tot + w[j];
+            }
+            loglik = loglik + big + log(tot);
+            for (j = 0; j < k; j++)
+            {
+                sw[j] = sw[j] + w[j] / tot;
+                swx[j] = swx[j] + data[i] * w[j] / tot;
+            }
+        }
+
+        // M-step -- new probabilities and means (drop empty phases)
+        for (j = 0; j < k; j++)
+        {
+            p[j] = sw[j] / n;
+            if (sw[j] > 0.0)
+                mean[j] = swx[j] / sw[j];
+        }
+
+        if (fabs(loglik - last_loglik) < EM_TOL * fabs(loglik))
+            break;
+        last_loglik = loglik;
+    }
+
+    hyper_set(s, k, p, mean);
+}
+
+//===========================================================================
+//=  Function to fill in a sampler from phase probabilities and means       =
+//===========================================================================
+void hyper_set(hyper_t *s, int k, double *p, double *mean)
+{
+    double sum;                   // Running sum of probabilities
+    int    j;                     // Loop counter
+
+    s->k = k;
+    sum = 0.0;
+    for (j = 0; j < k; j++)
+    {
+        sum = sum + p[j];
+        s->cum[j] = sum;
+        s->mean[j] = mean[j];
+    }
+    s->cum[k - 1] = 1.0;
+}
+
+//===========================================================================
+//=  Function to generate hyperexponentially distributed random variables   =
+//=    - Input:  Sampler from hyper_init()                                  =
+//=    - Output: Returns with hyperexponentially distributed rv             =
+//=    - One uniform picks the phase and, rescaled within the phase's       =
+//=      interval of cumulative probability, gives the exponential          =
+//===========================================================================
+double hyper_sample(hyper_t *s)
+{
+    double z;                     // Uniform random number from 0 to 1
+    double lo;                    // Start of the phase's interval
+    double hyp_value;             // Computed exponential value to be returned
+    int    j;                     // Phase
+
+    // Pull a uniform random number (0 < z < 1)
     do
     {
-        z2 = rand_val(0);
+        z = rand_val(0);
     }
-    while ((z2 == 0) || (z2 == 1));
+    while ((z == 0) || (z == 1));
 
-    // Compute hyperexponential random variable using Morse's method
-    temp = cov * cov;
-    p = 0.5 * (1.0 - sqrt((temp - 1.0) / (temp + 1.0)));
-    if (z1 > p)
-        temp = x / (1.0 - p);
-    else
-        temp = x / p;
-    hyp_value = -0.5 * temp * log(z2);
+    // Pick the phase and rescale z to (0, 1] within its interval
+    lo = 0.0;
+    for (j = 0; (j < s->k - 1) && (z > s->cum[j]); j++)
+        lo = s->cum[j];
+    z = (z - lo) / (s->cum[j] - lo);
+
+    // Compute hyperexponential random variable using inversion
+    hyp_value = -s->mean[j] * log(z);
 
     return(hyp_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with hyperexponentially distributed rvs      =
+//=    - Input:  Sampler from hyper_init(), buffer, and number of values    =
+//=    - Output: Fills buf[0] to buf[num - 1] with hyperexponential rvs     =
+//===========================================================================
+void hyper_fill(hyper_t *s, double *buf, int num)
+{
+    int      i;                   // Loop counter
+
+    for (i = 0; i < num; i++)
+        buf[i] = hyper_sample(s);
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
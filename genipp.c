@@ -4,6 +4,12 @@
 //=  Notes:  1) Write to a user specified output file                       =
 //=             * File format is <interarrival time delta>                  =
 //=          2) Generates samples for user specified time period            =
+//=          3) Optionally outputs the number of arrivals in each time bin  =
+//=             * ON and OFF sojourn times are drawn and each bin count is  =
+//=               a Poisson random variable with mean lambda times the ON   =
+//=               time in the bin, so work scales with bins and sojourns    =
+//=          4) Exponential times use inversion (one log() each) or the     =
+//=             Ziggurat method of Marsaglia and Tsang (expon_zig())        =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -16,6 +22,8 @@
 //=   On-to-off rate (alpha) =========================>  1.0                =
 //=   Off-to-on rate (beta) ==========================>  1.0                =
 //=   Time period to generate samples ================> 15.0                =
+//=   Output (1 = interarrivals, 2 = counts per bin) => 1                   =
+//=   Method (1 = inversion, 2 = Ziggurat) ===========> 1                   =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples for 15.00000 seconds...                         =
 //=   -    * lambda = 1.000000 customers per second                         =
@@ -63,10 +71,22 @@
 //----- Include files ---------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for log()
+#include <math.h>               // Needed for exp(), log(), and sqrt()
+
+//----- Defines ---------------------------------------------------------------
+#define PTRS_MIN_MEAN  10.0     // Smallest mean that uses the PTRS method
+#define EZIG_N     256          // Number of exponential Ziggurat layers
+#define EZIG_R     7.69711747013104972  // Start of the right-most tail
+#define EZIG_V     3.949659822581572e-3 // Area of each Ziggurat layer
+#define EZIG_M     2147483648.0 // 2^31 scale for unsigned 31-bit integers
 
 //----- Function prototypes ---------------------------------------------------
 double expon(double x);         // Returns an exponential random variable
+double expon_zig(double x);     // Ziggurat exponential random variable
+int    poisson(double x);       // Returns a Poisson random variable
+int    poisson_inv(double mu);  // Poisson rv using inversion
+int    poisson_ptrs(double mu); // Poisson rv using PTRS
+long   rand_bits(void);         // 31 random bits
 double rand_val(int seed);      // Jain's RNG
 
 //===== Main program ==========================================================
@@ -78,11 +98,19 @@ void main(void)
     double   alpha;               // IPP rate from on to off
     double   beta;                // IPP rate from off to on
     double   ipp_rv;              // IPP random variable
+    double   (*expon_rv)(double); // Exponential method (from the prompt)
     double   temp, temp1;         // Variables needed for IPP to H2 conversion
     double   lambda1, lambda2;    // Variables needed for IPP to H2 conversion
     double   pi1;                 // Variable needed for IPP to H2 conversion
     double   time_period ;        // Time period to generate arrival samples
     double   sum_time;            // Sum of time upto now
+    double   bin_width;           // Width of a time bin in seconds
+    double   bin_left;            // Time left in the current bin
+    double   on_time;             // ON time within the current bin
+    double   sojourn;             // Time left in the current ON or OFF state
+    int      on;                  // Current state (1 = ON, 0 = OFF)
+    int      output_mode;         // 1 = interarrivals, 2 = counts per bin
+    int      count;               // Number of arrivals in a bin
     long int i;                   // Loop counter
 
     //Output banner
@@ -125,6 +153,30 @@ void main(void)
     scanf("%s", in_string);
     time_period = atof(in_string);
 
+    // Prompt for output mode (and bin width for counts per bin)
+    printf("Output (1 = interarrivals, 2 = counts per bin) => ");
+    scanf("%s", in_string);
+    output_mode = atoi(in_string);
+    if (output_mode == 2)
+    {
+        printf("Bin width in seconds ===========================> ");
+        scanf("%s", in_string);
+        bin_width = atof(in_string);
+        if (bin_width <= 0.0)
+        {
+            printf("ERROR - bin width must be greater than 0 \n");
+            exit(1);
+        }
+    }
+
+    // Prompt for the exponential method
+    printf("Method (1 = inversion, 2 = Ziggurat) ===========> ");
+    scanf("%s", in_string);
+    if (atoi(in_string) == 2)
+        expon_rv = expon_zig;
+    else
+        expon_rv = expon;
+
     // Conversion from IPP to H2
     temp = (lambda + alpha + beta);
     temp1 = (4.0 * lambda * beta);
@@ -140,12 +192,40 @@ void main(void)
     printf("-    * beta   = %f transations per second \n", beta);
     printf("-------------------------------------------------------- \n");
     sum_time = 0.0;
-    while(1)
+    if (output_mode == 2)
+    {
+        // Start in the steady-state ON or OFF state
+        on = (rand_val(0) < (beta / (alpha + beta)));
+        sojourn = on ? expon_rv(1.0 / alpha) : expon_rv(1.0 / beta);
+
+        // Walk the bins, splitting each into ON and OFF time
+        for ( ; sum_time < time_period; sum_time = sum_time + bin_width)
+        {
+            on_time = 0.0;
+            bin_left = bin_width;
+            while (sojourn <= bin_left)
+            {
+                if (on) on_time = on_time + sojourn;
+                bin_left = bin_left - sojourn;
+                on = !on;
+                sojourn = on ? expon_rv(1.0 / alpha) : expon_rv(1.0 / beta);
+            }
+            if (on) on_time = on_time + bin_left;
+            sojourn = sojourn - bin_left;
+
+            // Arrivals in the bin are Poisson with mean lambda * on_time
+            count = 0;
+            if (on_time > 0.0)
+                count = poisson(1.0 / (lambda * on_time));
+            fprintf(fp, "%d \n", count);
+        }
+    }
+    else while(1)
     {
         if (rand_val(0) < pi1)
-            ipp_rv = expon(1.0 / lambda1);
+            ipp_rv = expon_rv(1.0 / lambda1);
         else
-            ipp_rv = expon(1.0 / lambda2);
+            ipp_rv = expon_rv(1.0 / lambda2);
 
         fprintf(fp, "%f \n", ipp_rv);
         sum_time = sum_time + ipp_rv;
@@ -178,6 +258,193 @@ double expon(double x)
     return(-x * log(z));
 }
 
+//===========================================================================
+//=  Function to generate exponentially distributed random variables using  =
+//=  the Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat      =
+//=  Method for Generating Random Variables," Journal of Statistical        =
+//=  Software, Vol. 5, No. 8, 2000.                                         =
+//=    - Input:  Mean value of distribution                                 =
+//=    - Output: Returns with exponentially distributed random variable     =
+//=    - About 98% of samples need one uniform and one table compare (no    =
+//=      log()).  The layer tables are built on the first call only.        =
+//===========================================================================
+double expon_zig(double x)
+{
+    static int    first = 1;        // Static first time flag
+    static double ke[EZIG_N];       // Fast path accept bounds for layers
+    static double we[EZIG_N];       // Layer widths scaled by 1 / 2^31
+    static double fe[EZIG_N];       // Exponential density at layer edges
+    double   de, te, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    int      iz;                    // Layer index
+    double   y;                     // Exponential(1) rv
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        de = te = EZIG_R;
+        q = EZIG_V / exp(-de);
+        ke[0] = (de / q) * EZIG_M;
+        ke[1] = 0.0;
+        we[0] = q / EZIG_M;
+        we[EZIG_N - 1] = de / EZIG_M;
+        fe[0] = 1.0;
+        fe[EZIG_N - 1] = exp(-de);
+        for (i = EZIG_N - 2; i >= 1; i--)
+        {
+            de = -log(EZIG_V / de + exp(-de));
+            ke[i + 1] = (de / te) * EZIG_M;
+            te = de;
+            fe[i] = exp(-de);
+            we[i] = de / EZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (EZIG_N - 1));
+    if (jz < ke[iz])
+        return(jz * we[iz] * x);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        if (iz == 0)
+        {
+            y = EZIG_R - log(rand_val(0));
+            break;
+        }
+        y = jz * we[iz];
+        if ((fe[iz] + rand_val(0) * (fe[iz - 1] - fe[iz])) < exp(-y))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (EZIG_N - 1));
+        if (jz < ke[iz])
+        {
+            y = jz * we[iz];
+            break;
+        }
+    }
+
+    return(y * x);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
+//=============================================================================
+//=  Function to generate Poisson distributed random variables                =
+//=    - Input:  Mean interarrival time (the Poisson mean is 1 / x)           =
+//=    - Output: Returns with Poisson distributed random variable             =
+//=============================================================================
+int poisson(double x)
+{
+    double mu;                    // Mean of the Poisson distribution
+
+    // Use inversion for small means and PTRS for large means
+    mu = 1.0 / x;
+    if (mu < PTRS_MIN_MEAN)
+        return(poisson_inv(mu));
+    else
+        return(poisson_ptrs(mu));
+}
+
+//=============================================================================
+//=  Function to generate Poisson random variables using inversion            =
+//=    - Input:  Mean of distribution (mu < PTRS_MIN_MEAN)                    =
+//=    - Output: Returns with Poisson distributed random variable             =
+//=    - Sequential search of the CDF using one uniform per value             =
+//=============================================================================
+int poisson_inv(double mu)
+{
+    static double last_mu = -1.0; // Mean used for exp_mu
+    static double exp_mu;         // Pre-computed exp(-mu)
+    double z;                     // Uniform random number (0 < z < 1)
+    double p;                     // Probability of poi_value
+    double sum_p;                 // Cumulative probability up to poi_value
+    int    poi_value;             // Computed Poisson value to be returned
+
+    // Recompute exp(-mu) only when the mean changes
+    if (mu != last_mu)
+    {
+        exp_mu = exp(-mu);
+        last_mu = mu;
+    }
+
+    // Search the CDF for the first value with sum_p >= z
+    z = rand_val(0);
+    poi_value = 0;
+    p = exp_mu;
+    sum_p = p;
+    while (z > sum_p)
+    {
+        poi_value++;
+        p = p * mu / poi_value;
+        sum_p = sum_p + p;
+    }
+
+    return(poi_value);
+}
+
+//=============================================================================
+//=  Function to generate Poisson random variables using the PTRS method      =
+//=  from W. Hormann, "The Transformed Rejection Method for Generating        =
+//=  Poisson Random Variables," Insurance: Mathematics and Economics,         =
+//=  Vol. 12, No. 1, 1993.                                                    =
+//=    - Input:  Mean of distribution (mu >= PTRS_MIN_MEAN)                   =
+//=    - Output: Returns with Poisson distributed random variable             =
+//=    - Uses about 2.3 uniforms per value and no log() for most values       =
+//=============================================================================
+int poisson_ptrs(double mu)
+{
+    static double last_mu = -1.0; // Mean used for the constants below
+    static double a, b;           // Hat function constants
+    static double inv_alpha;      // Hat function scale
+    static double v_r;            // Bound of the fast accept region
+    static double log_mu;         // Pre-computed log(mu)
+    static double log_inv_alpha;  // Pre-computed log(inv_alpha)
+    double u, v;                  // Uniform random numbers
+    double us;                    // Distance of u from the edges
+    double k;                     // Candidate Poisson value
+
+    // Recompute the constants only when the mean changes
+    if (mu != last_mu)
+    {
+        b = 0.931 + 2.53 * sqrt(mu);
+        a = -0.059 + 0.02483 * b;
+        inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+        v_r = 0.9277 - 3.6224 / (b - 2.0);
+        log_mu = log(mu);
+        log_inv_alpha = log(inv_alpha);
+        last_mu = mu;
+    }
+
+    // Transformed rejection with squeeze
+    while (1)
+    {
+        u = rand_val(0) - 0.5;
+        v = rand_val(0);
+        us = 0.5 - fabs(u);
+        k = floor((2.0 * a / us + b) * u + mu + 0.43);
+        if ((us >= 0.07) && (v <= v_r))
+            return((int) k);
+        if ((k < 0.0) || ((us < 0.013) && (v > us)))
+            continue;
+        if ((log(v) + log_inv_alpha - log(a / (us * us) + b))
+            <= (-mu + k * log_mu - lgamma(k + 1.0)))
+            return((int) k);
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -0,0 +1,279 @@
+//==================================================== file = genmask.c =====
+//=  Program to generate Bernoulli loss (or fault) masks 64 trials at a     =
+//=  time                                                                   =
+//===========================================================================
+//=  Notes: 1) Writes to a user specified output file                       =
+//=            * Bitmap format is packed 64-bit words (binary, native byte  =
+//=              order) where bit i of word w is trial 64 * w + i and a     =
+//=              one bit is a success (loss)                                =
+//=            * Run length format is one run length per line, alternating  =
+//=              runs of zeros and ones and starting with a run of zeros    =
+//=              (which may be of length 0)                                 =
+//=         2) Generates user specified number of trials                    =
+//=         3) Each trial is one with probability p rounded to MASK_BITS    =
+//=            binary digits.  Each word of 64 trials is built from the     =
+//=            binary expansion of p, lowest digit first, by OR-ing in a    =
+//=            random word for a one digit and AND-ing for a zero digit.    =
+//=            This halves and shifts the bit probability at each digit, so =
+//=            a word costs at most MASK_BITS random words (fewer when p    =
+//=            has trailing zero digits, e.g., 1 word for p = 0.5)          =
+//=         4) Uses a 64-bit splitmix RNG since 64 fair bits are needed per =
+//=            random word                                                  =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ---------------------------------------- genmask.c -----              =
+//=   -  Program to generate Bernoulli loss masks            -              =
+//=   --------------------------------------------------------              =
+//=   Output file name ===================================> output.dat      =
+//=   Random number seed (greater than 0) ================> 1               =
+//=   Probability of a one (loss) per trial ==============> 0.01            =
+//=   Number of trials (bits) to generate ================> 1000000         =
+//=   Output (1 = bitmap, 2 = run lengths) ===============> 2               =
+//=   --------------------------------------------------------              =
+//=   -  Generating samples to file                          -              =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc -O3 genmask.c                                               =
+//=-------------------------------------------------------------------------=
+//=  Execute: genmask                                                       =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from genbin.c)                          =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit() and ato*()
+#include <stdint.h>             // Needed for uint64_t
+
+//----- Defines -------------------------------------------------------------
+#define MASK_BITS      32       // Binary digits of p that are used
+#define MASK_BLOCK     1024     // Number of 64-bit words per batch
+
+//----- Function prototypes -------------------------------------------------
+void     mask_fill(uint64_t *buf, int num, double p);   // Batch of masks
+int      ctz64(uint64_t x);             // Count trailing zero bits
+uint64_t rand_val64(uint64_t seed);     // 64-bit splitmix RNG
+
+//===== Main program ========================================================
+int main(void)
+{
+    FILE     *fp;                 // File pointer to output file
+    char     file_name[256];      // Output file name string
+    char     temp_string[256];    // Temporary string variable
+    double   p;                   // Probability of a one per trial
+    double   num_trials;          // Number of trials to generate
+    double   trials_left;         // Number of trials still to output
+    int      output_mode;         // 1 = bitmap, 2 = run lengths
+    uint64_t mask[MASK_BLOCK];    // Batch of 64-trial mask words
+    uint64_t word;                // Mask word (or its complement)
+    uint64_t run;                 // Length of the current run
+    int      cur;                 // Bit value of the current run
+    int      num_words;           // Number of words in this batch
+    int      num_bits;            // Number of valid bits in a word
+    int      pos;                 // Bit position within a word
+    int      t;                   // Trailing zero count
+    int      i;                   // Loop counter
+
+    // Output banner
+    printf("---------------------------------------- genmask.c ----- \n");
+    printf("-  Program to generate Bernoulli loss masks            - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for output filename and then create/open the file
+    printf("Output file name ===================================> ");
+    scanf("%s", file_name);
+    fp = fopen(file_name, "wb");
+    if (fp == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", file_name);
+        exit(1);
+    }
+
+    // Prompt for random number seed and then use it
+    printf("Random number seed (greater than 0) ================> ");
+    scanf("%s", temp_string);
+    rand_val64((uint64_t) atoll(temp_string));
+
+    // Prompt for probability of a one
+    printf("Probability of a one (loss) per trial ==============> ");
+    scanf("%s", temp_string);
+    p = atof(temp_string);
+
+    // Prompt for number of trials
+    printf("Number of trials (bits) to generate ================> ");
+    scanf("%s", temp_string);
+    num_trials = atof(temp_string);
+
+    // Prompt for output mode
+    printf("Output (1 = bitmap, 2 = run lengths) ===============> ");
+    scanf("%s", temp_string);
+    output_mode = atoi(temp_string);
+
+    // Output message and generate masks
+    printf("-------------------------------------------------------- \n");
+    printf("-  Generating samples to file                          - \n");
+    printf("-------------------------------------------------------- \n");
+    cur = 0;
+    run = 0;
+    for (trials_left = num_trials; trials_left > 0; )
+    {
+        num_words = MASK_BLOCK;
+        if (num_words > (trials_left + 63) / 64)
+            num_words = (int) ((trials_left + 63) / 64);
+        mask_fill(mask, num_words, p);
+
+        // Clear the unused bits of the last word
+        if (trials_left < 64.0 * num_words)
+        {
+            num_bits = (int) (trials_left - 64.0 * (num_words - 1));
+            mask[num_words - 1] &= (((uint64_t) 1) << num_bits) - 1;
+        }
+
+        // Output packed words
+        if (output_mode != 2)
+        {
+            fwrite(mask, sizeof(uint64_t), num_words, fp);
+            trials_left = trials_left - 64.0 * num_words;
+            continue;
+        }
+
+        // Output run lengths, jumping from one bit change to the next
+        for (i = 0; i < num_words; i++)
+        {
+            num_bits = (trials_left < 64.0) ? (int) trials_left : 64;
+            pos = 0;
+            while (pos < num_bits)
+            {
+                word = (cur ? ~mask[i] : mask[i]) >> pos;
+                if (num_bits - pos < 64)
+                    word &= (((uint64_t) 1) << (num_bits - pos)) - 1;
+                if (word == 0)
+                {
+                    run = run + (num_bits - pos);
+                    break;
+                }
+                t = ctz64(word);
+                fprintf(fp, "%llu \n", (unsigned long long) (run + t));
+                cur = !cur;
+                run = 0;
+                pos = pos + t;
+            }
+            trials_left = trials_left - num_bits;
+        }
+    }
+    if (output_mode == 2)
+        fprintf(fp, "%llu \n", (unsigned long long) run);
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp);
+    return(0);
+}
+
+//===========================================================================
+//=  Function to fill a buffer with Bernoulli mask words                    =
+//=    - Input:  Buffer, number of 64-bit words, and p                      =
+//=    - Output: Fills buf[0] to buf[num - 1] with words whose bits are     =
+//=      independently one with probability p (to MASK_BITS digits)         =
+//=    - The combine loop runs over a whole block for each digit of p so    =
+//=      that the compiler can vectorize it                                 =
+//===========================================================================
+void mask_fill(uint64_t *buf, int num, double p)
+{
+    uint64_t pk;                  // p scaled to MASK_BITS binary digits
+    uint64_t r[MASK_BLOCK];       // Block of random words
+    int      lo;                  // Lowest one digit of pk
+    int      j;                   // Digit of pk
+    int      i, k, n;             // Loop counters and block size
+
+    // Scale p and handle the all zeros and all ones cases
+    if (p <= 0.0)
+        pk = 0;
+    else if (p >= 1.0)
+        pk = ((uint64_t) 1) << MASK_BITS;
+    else
+        pk = (uint64_t) (p * (double) (((uint64_t) 1) << MASK_BITS) + 0.5);
+    if ((pk == 0) || (pk == (((uint64_t) 1) << MASK_BITS)))
+    {
+        for (i = 0; i < num; i++)
+            buf[i] = (pk == 0) ? 0 : ~((uint64_t) 0);
+        return;
+    }
+    lo = ctz64(pk);
+
+    for (k = 0; k < num; k = k + n)
+    {
+        n = num - k;
+        if (n > MASK_BLOCK)
+            n = MASK_BLOCK;
+
+        // The lowest one digit starts the word at probability 1/2
+        for (i = 0; i < n; i++)
+            buf[k + i] = rand_val64(0);
+
+        // Each higher digit ORs (one) or ANDs (zero) in a random word
+        for (j = lo + 1; j < MASK_BITS; j++)
+        {
+            for (i = 0; i < n; i++)
+                r[i] = rand_val64(0);
+            if ((pk >> j) & 1)
+                for (i = 0; i < n; i++)
+                    buf[k + i] = buf[k + i] | r[i];
+            else
+                for (i = 0; i < n; i++)
+                    buf[k + i] = buf[k + i] & r[i];
+        }
+    }
+}
+
+//===========================================================================
+//=  Function to count trailing zero bits of a non-zero 64-bit word         =
+//===========================================================================
+int ctz64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return(__builtin_ctzll(x));
+#else
+    int n = 0;                    // Number of trailing zeros
+
+    while ((x & 1) == 0)
+    {
+        x = x >> 1;
+        n++;
+    }
+    return(n);
+#endif
+}
+
+//=========================================================================
+//= 64-bit splitmix RNG for generating uniform 64-bit random words        =
+//=   - x_n = x_(n-1) + 0x9e3779b97f4a7c15 and output is a mix of x_n     =
+//=   - Seeding follows rand_val() (a seed greater than 0 sets the state  =
+//=     and returns zero)                                                 =
+//=   - From S. Vigna, "splitmix64.c," http://prng.di.unimi.it/           =
+//=========================================================================
+uint64_t rand_val64(uint64_t seed)
+{
+    static uint64_t x;           // State of the RNG
+    uint64_t        z;           // Mixed output value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0);
+    }
+
+    // Advance the state and mix it
+    x = x + 0x9e3779b97f4a7c15ULL;
+    z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return(z ^ (z >> 31));
+}
@@ -0,0 +1,598 @@
+//==================================================== file = genmmpp.c =====
+//=  Program to generate MMPP interarrival times                            =
+//===========================================================================
+//=  Notes: 1) Writes to a user specified output file                       =
+//=             * File format is <interarrival time delta>                  =
+//=         2) Generates samples for user specified time period             =
+//=         3) Reads the Markov modulated Poisson process (MMPP) from a     =
+//=            user specified file.  The file format is the number of       =
+//=            states n, then the n arrival rates, then the n x n generator =
+//=            matrix Q by rows (rows sum to zero).  The IPP in genipp.c is =
+//=            the n = 2 MMPP with rates lambda and 0 and Q = [-alpha       =
+//=            alpha; beta -beta].                                          =
+//=         4) Sojourns are sampled exactly.  In state i the next event is  =
+//=            exponential with rate lambda_i + q_i (q_i = -Q[i][i]) and is =
+//=            an arrival with probability lambda_i / (lambda_i + q_i) and  =
+//=            otherwise a jump to state j with probability                 =
+//=            Q[i][j] / (lambda_i + q_i).  Each state has an alias table   =
+//=            over these outcomes so that each event costs one uniform and =
+//=            one table lookup for the outcome.                            =
+//=         5) The first state is drawn from the stationary distribution    =
+//=            of Q (solved by Gaussian elimination)                        =
+//=         6) Interarrival times are generated in batches with the event   =
+//=            time log()s in one loop (in-line polynomial log() that       =
+//=            vectorizes) after the event chains are walked                =
+//=-------------------------------------------------------------------------=
+//= Example MMPP file ("mmpp.dat" for a 3-state MMPP):                      =
+//=                                                                         =
+//=   3                                                                     =
+//=   1.0   10.0  100.0                                                     =
+//=   -0.2  0.1   0.1                                                       =
+//=   0.5   -1.0  0.5                                                       =
+//=   1.0   1.0   -2.0                                                      =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ---------------------------------------- genmmpp.c -----              =
+//=   -  Program to generate MMPP interarrival times         -              =
+//=   --------------------------------------------------------              =
+//=   Output file name ===================================> output.dat      =
+//=   Random number seed =================================> 1               =
+//=   MMPP file name =====================================> mmpp.dat        =
+//=   Time period to generate samples ====================> 1000.0          =
+//=   --------------------------------------------------------              =
+//=   -  Generating samples for 1000.000000 seconds...                      =
+//=   -    * mean rate = 10.000000 customers per second                     =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc genmmpp.c -lm, bcc32 genmmpp.c                              =
+//=-------------------------------------------------------------------------=
+//=  Execute: genmmpp                                                       =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from genipp.c and genph.c)              =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <string.h>             // Needed for memcpy()
+#include <math.h>               // Needed for fabs()
+
+//----- Defines -------------------------------------------------------------
+#define MMPP_BLOCK 1024         // Number of values generated per batch
+#define MMPP_EPS   1.0e-9       // Tolerance for row sums of Q
+#define MMPP_MAX   1073741824   // Largest work buffer (2^30 event times)
+#define LN2_D      0.693147180559945309 // Natural log of 2
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                  // MMPP sampler built by mmpp_init()
+{
+    int    n;                   // Number of states
+    int    state;               // Current state
+    double *mean;               // Mean time to the next event in each state
+    double *prob;               // Alias probabilities, n + 1 rows of n
+    int    *alias;              // Alias outcomes, n + 1 rows of n
+    double *u;                  // Event time uniforms for a batch
+    double *w;                  // Event time means for a batch
+    int    num_work;            // Size of the u[] and w[] buffers
+    int    *count;              // Number of events of each interarrival
+    int    num_count;           // Size of the count[] buffer
+} mmpp_t;
+
+//----- Function prototypes -------------------------------------------------
+int    mmpp_init(mmpp_t *s, int n, double *lambda, double *q, double *pi);
+void   mmpp_fill(mmpp_t *s, double *buf, int num);  // Batch of interarrivals
+int    mmpp_next(mmpp_t *s, int row);   // Next outcome from an alias table
+void   mmpp_grow(mmpp_t *s);            // Doubles the batch work buffers
+int    stationary(double *q, int n, double *pi);  // Solves pi * Q = 0
+void   alias_init(double *p, int n, double *prob, int *alias);
+static double poly_log(double x);       // Polynomial log()
+double rand_val(int seed);              // Jain's RNG
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_in;                // File pointer to MMPP file
+    FILE     *fp_out;               // File pointer to output file
+    char     instring[256];         // Input string
+    int      n;                     // Number of states
+    double   *lambda;               // Arrival rate in each state
+    double   *q;                    // Generator matrix (by rows)
+    double   *pi;                   // Stationary distribution of Q
+    mmpp_t   mmpp;                  // MMPP sampler
+    double   buf[MMPP_BLOCK];       // Batch of interarrival times
+    double   mean_rate;             // Mean arrival rate
+    double   time_period;           // Time period to generate samples
+    double   sum_time;              // Sum of time up to now
+    int      i;                     // Loop counter
+
+    // Output banner
+    printf("---------------------------------------- genmmpp.c ----- \n");
+    printf("-  Program to generate MMPP interarrival times         - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for output filename and then create/open the file
+    printf("Output file name ===================================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Prompt for random number seed and then use it
+    printf("Random number seed =================================> ");
+    scanf("%s", instring);
+    rand_val((int) atoi(instring));
+
+    // Prompt for MMPP filename and then open the file
+    printf("MMPP file name =====================================> ");
+    scanf("%s", instring);
+    fp_in = fopen(instring, "r");
+    if (fp_in == NULL)
+    {
+        printf("ERROR in opening MMPP file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Read the number of states, arrival rates, and Q
+    if ((fscanf(fp_in, "%d", &n) != 1) || (n < 1))
+    {
+        printf("ERROR in reading number of states from MMPP file \n");
+        exit(1);
+    }
+    lambda = (double *) malloc(n * sizeof(double));
+    q = (double *) malloc(n * n * sizeof(double));
+    pi = (double *) malloc(n * sizeof(double));
+    if ((lambda == NULL) || (q == NULL) || (pi == NULL))
+    {
+        printf("ERROR - could not malloc space for arrays \n");
+        exit(1);
+    }
+    for (i = 0; i < n; i++)
+        if (fscanf(fp_in, "%lf", &lambda[i]) != 1)
+        {
+            printf("ERROR in reading arrival rates from MMPP file \n");
+            exit(1);
+        }
+    for (i = 0; i < n * n; i++)
+        if (fscanf(fp_in, "%lf", &q[i]) != 1)
+        {
+            printf("ERROR in reading Q from MMPP file \n");
+            exit(1);
+        }
+    fclose(fp_in);
+
+    // Prompt for time period (seconds) to generate samples
+    printf("Time period to generate samples ====================> ");
+    scanf("%s", instring);
+    time_period = atof(instring);
+
+    // Solve for the stationary distribution and build the alias tables
+    if (stationary(q, n, pi) != 0)
+    {
+        printf("ERROR - Q does not have a unique stationary distribution \n");
+        exit(1);
+    }
+    if (mmpp_init(&mmpp, n, lambda, q, pi) != 0)
+    {
+        printf("ERROR - arrival rates and Q are not a valid MMPP \n");
+        exit(1);
+    }
+    mean_rate = 0.0;
+    for (i = 0; i < n; i++)
+        mean_rate = mean_rate + pi[i] * lambda[i];
+
+    // Output message and generate samples
+    printf("-------------------------------------------------------- \n");
+    printf("-  Generating samples for %f seconds...   \n", time_period);
+    printf("-    * mean rate = %f customers per second \n", mean_rate);
+    printf("-------------------------------------------------------- \n");
+    sum_time = 0.0;
+    while (sum_time < time_period)
+    {
+        mmpp_fill(&mmpp, buf, MMPP_BLOCK);
+        for (i = 0; (i < MMPP_BLOCK) && (sum_time < time_period); i++)
+        {
+            fprintf(fp_out, "%f \n", buf[i]);
+            sum_time = sum_time + buf[i];
+        }
+    }
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+}
+
+//===========================================================================
+//=  Function to build an MMPP sampler                                      =
+//=    - Input:  Sampler, number of states n, arrival rates, Q (by rows),   =
+//=      and stationary distribution pi                                     =
+//=    - Output: Fills in the sampler (with the current state drawn from    =
+//=      pi) and returns 0, or returns -1 if the rates or Q are not valid   =
+//=      or the mean arrival rate under pi is zero                          =
+//=    - Row i < n of the alias tables is the next event in state i, where  =
+//=      outcome i is an arrival and outcome j != i is a jump to state j.   =
+//=      Row n is pi.                                                       =
+//===========================================================================
+int mmpp_init(mmpp_t *s, int n, double *lambda, double *q, double *pi)
+{
+    double   *p;                    // Probabilities for one row
+    double   rate;                  // Total event rate in a state
+    double   sum;                   // Row sum of Q
+    double   mean_rate;             // Mean arrival rate under pi
+    int      i, j;                  // Loop counters
+
+    s->n = n;
+    s->mean = (double *) malloc(n * sizeof(double));
+    s->prob = (double *) malloc((n + 1) * n * sizeof(double));
+    s->alias = (int *) malloc((n + 1) * n * sizeof(int));
+    s->num_work = MMPP_BLOCK;
+    s->u = (double *) malloc(s->num_work * sizeof(double));
+    s->w = (double *) malloc(s->num_work * sizeof(double));
+    s->num_count = MMPP_BLOCK;
+    s->count = (int *) malloc(s->num_count * sizeof(int));
+    p = (double *) malloc(n * sizeof(double));
+    if ((s->mean == NULL) || (s->prob == NULL) || (s->alias == NULL) ||
+        (s->u == NULL) || (s->w == NULL) || (s->count == NULL) || (p == NULL))
+    {
+        printf("ERROR - could not malloc space for alias tables \n");
+        exit(1);
+    }
+
+    // Next event in each state (outcome i is an arrival)
+    mean_rate = 0.0;
+    for (i = 0; i < n; i++)
+    {
+        if (lambda[i] < 0.0)
+            return(-1);
+        sum = 0.0;
+        for (j = 0; j < n; j++)
+        {
+            if ((j != i) && (q[i * n + j] < 0.0))
+                return(-1);
+            sum = sum + q[i * n + j];
+        }
+        if (fabs(sum) > MMPP_EPS * (1.0 - q[i * n + i]))
+            return(-1);
+        rate = lambda[i] - q[i * n + i];
+        if (rate <= 0.0)
+            return(-1);
+        s->mean[i] = 1.0 / rate;
+        mean_rate = mean_rate + pi[i] * lambda[i];
+        for (j = 0; j < n; j++)
+            p[j] = (j == i) ? (lambda[i] / rate) : (q[i * n + j] / rate);
+        alias_init(p, n, &s->prob[i * n], &s->alias[i * n]);
+    }
+
+    // There must be arrivals in the steady state (or filling never ends)
+    if (mean_rate <= 0.0)
+        return(-1);
+
+    // Start in the steady state
+    alias_init(pi, n, &s->prob[n * n], &s->alias[n * n]);
+    s->state = mmpp_next(s, n);
+
+    free(p);
+    return(0);
+}
+
+//===========================================================================
+//=  Function to fill a buffer with MMPP interarrival times                 =
+//=    - Input:  Sampler from mmpp_init(), buffer, and number of values     =
+//=    - Output: Fills buf[0] to buf[num - 1] with interarrival times       =
+//=      (the sampler keeps its state between calls)                        =
+//=    - The event chains are walked first, saving the event time uniforms  =
+//=      and means, then the log()s are done in one loop that the compiler  =
+//=      can vectorize, and then the event times are summed per arrival.    =
+//===========================================================================
+void mmpp_fill(mmpp_t *s, double *buf, int num)
+{
+    int      num_event;             // Number of event times saved
+    int      next;                  // Next outcome
+    int      i, j, k;               // Loop counters
+
+    // Grow the count buffer if needed
+    if (num > s->num_count)
+    {
+        s->num_count = num;
+        s->count = (int *) realloc(s->count, s->num_count * sizeof(int));
+        if (s->count == NULL)
+        {
+            printf("ERROR - could not realloc space for work buffers \n");
+            exit(1);
+        }
+    }
+
+    // Walk the event chains
+    num_event = 0;
+    for (i = 0; i < num; i++)
+    {
+        s->count[i] = 0;
+        do
+        {
+            // Grow the work buffers if needed
+            if (num_event == s->num_work)
+                mmpp_grow(s);
+            s->u[num_event] = rand_val(0);
+            s->w[num_event] = s->mean[s->state];
+            num_event++;
+            s->count[i]++;
+
+            // An outcome equal to the state is an arrival
+            next = mmpp_next(s, s->state);
+            if (next == s->state)
+                break;
+            s->state = next;
+        }
+        while (1);
+    }
+
+    // Compute the event times using the inversion method
+    for (k = 0; k < num_event; k++)
+        s->u[k] = -s->w[k] * poly_log(s->u[k]);
+
+    // Sum the event times for each interarrival time
+    k = 0;
+    for (i = 0; i < num; i++)
+    {
+        buf[i] = 0.0;
+        for (j = 0; j < s->count[i]; j++)
+            buf[i] = buf[i] + s->u[k++];
+    }
+}
+
+//===========================================================================
+//=  Function to pick the next outcome from one row of the alias tables     =
+//=    - Input:  Sampler and row (a state, or n for pi)                     =
+//=    - Output: Returns the outcome                                        =
+//=    - One uniform gives both the column (integer part of z * n) and the  =
+//=      alias test (fraction part)                                         =
+//===========================================================================
+int mmpp_next(mmpp_t *s, int row)
+{
+    double   z;                     // Uniform random number scaled by n
+    int      col;                   // Alias table column
+
+    z = rand_val(0) * s->n;
+    col = (int) z;
+    row = row * s->n;
+    if ((z - col) < s->prob[row + col])
+        return(col);
+    return(s->alias[row + col]);
+}
+
+//===========================================================================
+//=  Function to double the size of the batch work buffers of a sampler     =
+//=    - Stops at MMPP_MAX event times so that the int counts in            =
+//=      mmpp_fill() cannot overflow (rates that are tiny next to Q need    =
+//=      very many jumps per arrival)                                       =
+//===========================================================================
+void mmpp_grow(mmpp_t *s)
+{
+    if (s->num_work >= MMPP_MAX)
+    {
+        printf("ERROR - too many state jumps per batch of arrivals \n");
+        exit(1);
+    }
+    s->num_work = 2 * s->num_work;
+    s->u = (double *) realloc(s->u, s->num_work * sizeof(double));
+    s->w = (double *) realloc(s->w, s->num_work * sizeof(double));
+    if ((s->u == NULL) || (s->w == NULL))
+    {
+        printf("ERROR - could not realloc space for work buffers \n");
+        exit(1);
+    }
+}
+
+//===========================================================================
+//=  Function to solve for the stationary distribution of a generator       =
+//=    - Input:  n x n generator matrix q (by rows) and n                   =
+//=    - Output: Fills pi[] so that pi * Q = 0 and sum(pi) = 1 and returns  =
+//=      0, or returns -1 if the solution is not unique                     =
+//=    - Solves Q^T * pi = 0 with the last equation replaced by             =
+//=      sum(pi) = 1 using Gaussian elimination with partial pivoting       =
+//===========================================================================
+int stationary(double *q, int n, double *pi)
+{
+    double   *a;                    // Augmented matrix, n rows of n + 1
+    double   f, big;                // Row factor and largest pivot
+    int      piv;                   // Pivot row
+    int      i, j, k;               // Loop counters
+
+    a = (double *) malloc(n * (n + 1) * sizeof(double));
+    if (a == NULL)
+    {
+        printf("ERROR - could not malloc space for stationary solve \n");
+        exit(1);
+    }
+
+    // Build [Q^T | 0] and replace the last row with sum(pi) = 1
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n; j++)
+            a[i * (n + 1) + j] = (i == n - 1) ? 1.0 : q[j * n + i];
+        a[i * (n + 1) + n] = (i == n - 1) ? 1.0 : 0.0;
+    }
+
+    // Forward elimination with partial pivoting
+    for (k = 0; k < n; k++)
+    {
+        piv = k;
+        big = fabs(a[k * (n + 1) + k]);
+        for (i = k + 1; i < n; i++)
+            if (fabs(a[i * (n + 1) + k]) > big)
+            {
+                big = fabs(a[i * (n + 1) + k]);
+                piv = i;
+            }
+        if (big < MMPP_EPS)
+        {
+            free(a);
+            return(-1);
+        }
+        if (piv != k)
+            for (j = 0; j <= n; j++)
+            {
+                f = a[k * (n + 1) + j];
+                a[k * (n + 1) + j] = a[piv * (n + 1) + j];
+                a[piv * (n + 1) + j] = f;
+            }
+        for (i = k + 1; i < n; i++)
+        {
+            f = a[i * (n + 1) + k] / a[k * (n + 1) + k];
+            for (j = k; j <= n; j++)
+                a[i * (n + 1) + j] -= f * a[k * (n + 1) + j];
+        }
+    }
+
+    // Back substitution (clamping round-off below zero)
+    for (i = n - 1; i >= 0; i--)
+    {
+        f = a[i * (n + 1) + n];
+        for (j = i + 1; j < n; j++)
+            f = f - a[i * (n + 1) + j] * pi[j];
+        pi[i] = f / a[i * (n + 1) + i];
+    }
+    for (i = 0; i < n; i++)
+        if (pi[i] < 0.0)
+            pi[i] = 0.0;
+
+    free(a);
+    return(0);
+}
+
+//===========================================================================
+//=  Function to build an alias table using Vose's method                   =
+//=    - Input:  Probabilities p[0] to p[n - 1] (summing to 1)              =
+//=    - Output: Fills prob[] and alias[] so that outcome j is column j if  =
+//=      a uniform fraction is less than prob[j] and alias[j] otherwise     =
+//===========================================================================
+void alias_init(double *p, int n, double *prob, int *alias)
+{
+    int      *small, *large;        // Stacks of under and over full columns
+    int      num_small, num_large;  // Stack sizes
+    double   sum;                   // Sum of p[] for normalizing
+    int      s, l;                  // Small and large column
+    int      j;                     // Loop counter
+
+    small = (int *) malloc(n * sizeof(int));
+    large = (int *) malloc(n * sizeof(int));
+    if ((small == NULL) || (large == NULL))
+    {
+        printf("ERROR - could not malloc space for alias tables \n");
+        exit(1);
+    }
+
+    // Scale the probabilities to an average of 1 per column
+    sum = 0.0;
+    for (j = 0; j < n; j++)
+        sum = sum + p[j];
+    num_small = num_large = 0;
+    for (j = 0; j < n; j++)
+    {
+        prob[j] = p[j] * n / sum;
+        alias[j] = j;
+        if (prob[j] < 1.0)
+            small[num_small++] = j;
+        else
+            large[num_large++] = j;
+    }
+
+    // Fill each small column from a large column
+    while ((num_small > 0) && (num_large > 0))
+    {
+        s = small[--num_small];
+        l = large[--num_large];
+        alias[s] = l;
+        prob[l] = (prob[l] + prob[s]) - 1.0;
+        if (prob[l] < 1.0)
+            small[num_small++] = l;
+        else
+            large[num_large++] = l;
+    }
+
+    // Left over columns are full (up to round-off)
+    while (num_large > 0)
+        prob[large[--num_large]] = 1.0;
+    while (num_small > 0)
+        prob[small[--num_small]] = 1.0;
+
+    free(small);
+    free(large);
+}
+
+//===========================================================================
+//=  Function to compute log(x) for x > 0 without calling libm              =
+//=    - Splits x into 2^e * m with sqrt(1/2) <= m < sqrt(2) and then uses  =
+//=      log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172      =
+//=    - Accurate to within a few ulps for normal (non-denormal) x          =
+//===========================================================================
+static double poly_log(double x)
+{
+    unsigned long long bits;      // Bits of x
+    unsigned long long k;         // Biased exponent of x / sqrt(1/2)
+    unsigned long long ebits;     // Bits of 2^52 plus k
+    double    e, m, s, s2;        // Exponent, mantissa, and atanh variables
+
+    // Split x into 2^e * m with integer operations only (no compares and
+    // no integer to double conversion so that loops vectorize)
+    memcpy(&bits, &x, sizeof(bits));
+    k = (bits - 0x3fe6a09e667f3bcdULL + 0x4000000000000000ULL) >> 52;
+    ebits = k | 0x4330000000000000ULL;
+    memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1024.0);
+    bits = bits - (k << 52) + 0x4000000000000000ULL;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Series for atanh(s) up to the s^17 term
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    return((e * LN2_D) + 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5
+        + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 * (1.0 / 11 + s2 * (1.0 / 13
+        + s2 * (1.0 / 15 + s2 * (1.0 / 17))))))))));
+}
+
+//=========================================================================
+//= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
+//=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
+//=   - With x seeded to 1 the 10000th x value should be 1043618065       =
+//=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
+//=     John Wiley & Sons, 1991. (Page 443, Figure 26.2)                  =
+//=========================================================================
+double rand_val(int seed)
+{
+    const long  a =      16807;  // Multiplier
+    const long  m = 2147483647;  // Modulus
+    const long  q =     127773;  // m div a
+    const long  r =       2836;  // m mod a
+    static long x;               // Random int value
+    long        x_div_q;         // x divided by q
+    long        x_mod_q;         // x modulo q
+    long        x_new;           // New x value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0.0);
+    }
+
+    // RNG using integer arithmetic
+    x_div_q = x / q;
+    x_mod_q = x % q;
+    x_new = (a * x_mod_q) - (r * x_div_q);
+    if (x_new > 0)
+        x = x_new;
+    else
+        x = x_new + m;
+
+    // Return a random value between 0.0 and 1.0
+    return((double) x / m);
+}
@@ -0,0 +1,430 @@
+//===================================================== file = genmvn.c =====
+//=  Program to generate correlated multivariate normal random vectors      =
+//===========================================================================
+//=  Notes: 1) Writes to a user specified output file                       =
+//=            * File format is one vector of d values per line             =
+//=         2) Generates user specified number of vectors                   =
+//=         3) Reads the mean vector and covariance matrix from a user      =
+//=            specified file.  The file format is the dimension d, then    =
+//=            the d means, then the d x d covariance matrix by rows.       =
+//=         4) Factors the covariance matrix once as C = L * L^T using a    =
+//=            blocked Cholesky method and then generates vectors in        =
+//=            batches as X = Z * L^T + mean, where Z is a batch of iid     =
+//=            normal(0, 1) vectors (Ziggurat method as in gennorm.c)       =
+//=-------------------------------------------------------------------------=
+//= Example covariance file ("cov.dat"):                                    =
+//=                                                                         =
+//=   2                                                                     =
+//=   10.0  20.0                                                            =
+//=   4.0   1.2                                                             =
+//=   1.2   1.0                                                             =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ----------------------------------------- genmvn.c -----              =
+//=   -  Program to generate multivariate normal random      -              =
+//=   -  vectors                                             -              =
+//=   --------------------------------------------------------              =
+//=   Output file name ===================================> output.dat      =
+//=   Random number seed =================================> 1               =
+//=   Covariance file name ===============================> cov.dat         =
+//=   Number of vectors to generate ======================> 10              =
+//=   --------------------------------------------------------              =
+//=   -  Generating samples to file                          -              =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc genmvn.c -lm, bcc32 genmvn.c                                =
+//=-------------------------------------------------------------------------=
+//=  Execute: genmvn                                                        =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from gennorm.c)                         =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <string.h>             // Needed for memcpy()
+#include <math.h>               // Needed for sqrt(), log(), and exp()
+
+//----- Defines -------------------------------------------------------------
+#define ZIG_N      128          // Number of Ziggurat layers
+#define ZIG_R      3.442619855899       // Start of the right-most tail
+#define ZIG_V      9.91256303526217e-3  // Area of each Ziggurat layer
+#define ZIG_M      1073741824.0 // 2^30 scale for signed 31-bit integers
+#define MVN_BLOCK  64           // Block size for Cholesky and products
+#define MVN_BATCH  256          // Number of vectors generated per batch
+
+//----- Function prototypes -------------------------------------------------
+int    cholesky(double *c, int d);             // Blocked Cholesky of c
+void   mvn_fill(double *x, double *z, int num, double *lt, double *mean,
+         int d);                               // Batch of correlated rvs
+double norm_zig(double mean, double std_dev);  // Ziggurat normal rv
+long   rand_bits(void);                        // 31 random bits
+double rand_val(int seed);                     // Jain's RNG
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_in;                // File pointer to covariance file
+    FILE     *fp_out;               // File pointer to output file
+    char     instring[256];         // Input string
+    int      d;                     // Dimension of the vectors
+    double   *mean;                 // Mean vector
+    double   *c;                    // Covariance matrix, then L^T
+    double   *x;                    // Batch of correlated normal vectors
+    double   *z;                    // Batch of iid normal vectors
+    int      num_vectors;           // Number of vectors to generate
+    int      n;                     // Number of vectors in this batch
+    int      i, j;                  // Loop counters
+
+    // Output banner
+    printf("----------------------------------------- genmvn.c ----- \n");
+    printf("-  Program to generate multivariate normal random      - \n");
+    printf("-  vectors                                             - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for output filename and then create/open the file
+    printf("Output file name ===================================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Prompt for random number seed and then use it
+    printf("Random number seed =================================> ");
+    scanf("%s", instring);
+    rand_val((int) atoi(instring));
+
+    // Prompt for covariance filename and then open the file
+    printf("Covariance file name ===============================> ");
+    scanf("%s", instring);
+    fp_in = fopen(instring, "r");
+    if (fp_in == NULL)
+    {
+        printf("ERROR in opening covariance file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Read the dimension, mean vector, and covariance matrix
+    if ((fscanf(fp_in, "%d", &d) != 1) || (d < 1))
+    {
+        printf("ERROR in reading dimension from covariance file \n");
+        exit(1);
+    }
+    mean = (double *) malloc(d * sizeof(double));
+    c = (double *) malloc(d * d * sizeof(double));
+    x = (double *) malloc(MVN_BATCH * d * sizeof(double));
+    z = (double *) malloc(MVN_BATCH * d * sizeof(double));
+    if ((mean == NULL) || (c == NULL) || (x == NULL) || (z == NULL))
+    {
+        printf("ERROR - could not malloc space for arrays \n");
+        exit(1);
+    }
+    for (i = 0; i < d; i++)
+        if (fscanf(fp_in, "%lf", &mean[i]) != 1)
+        {
+            printf("ERROR in reading mean vector from covariance file \n");
+            exit(1);
+        }
+    for (i = 0; i < d * d; i++)
+        if (fscanf(fp_in, "%lf", &c[i]) != 1)
+        {
+            printf("ERROR in reading covariance matrix from file \n");
+            exit(1);
+        }
+    fclose(fp_in);
+
+    // Prompt for number of vectors to generate
+    printf("Number of vectors to generate ======================> ");
+    scanf("%s", instring);
+    num_vectors = atoi(instring);
+
+    // Factor the covariance matrix once
+    if (cholesky(c, d) != 0)
+    {
+        printf("ERROR - covariance matrix is not positive definite \n");
+        exit(1);
+    }
+
+    // Output message and generate vectors
+    printf("-------------------------------------------------------- \n");
+    printf("-  Generating samples to file                          - \n");
+    printf("-------------------------------------------------------- \n");
+    for (i = 0; i < num_vectors; i = i + n)
+    {
+        n = MVN_BATCH;
+        if (n > num_vectors - i)
+            n = num_vectors - i;
+        mvn_fill(x, z, n, c, mean, d);
+        for (j = 0; j < n * d; j++)
+        {
+            fprintf(fp_out, "%f ", x[j]);
+            if ((j % d) == (d - 1))
+                fprintf(fp_out, "\n");
+        }
+    }
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+}
+
+//===========================================================================
+//=  Function to factor a covariance matrix using the Cholesky method       =
+//=    - Input: d x d symmetric matrix c (by rows) and dimension d          =
+//=    - Output: Overwrites c with L^T (upper triangular, by rows) where    =
+//=      C = L * L^T and returns 0, or returns -1 if c is not positive      =
+//=      definite                                                           =
+//=    - Works on the lower triangle in MVN_BLOCK x MVN_BLOCK blocks so     =
+//=      that the trailing update (most of the work) stays in cache         =
+//===========================================================================
+int cholesky(double *c, int d)
+{
+    int      kb, kend;              // Current block column and its end
+    int      ib, iend, jb, jend;    // Trailing update blocks
+    double   sum;                   // Dot product
+    int      i, j, k;               // Loop counters
+
+    for (kb = 0; kb < d; kb = kb + MVN_BLOCK)
+    {
+        kend = kb + MVN_BLOCK;
+        if (kend > d)
+            kend = d;
+
+        // Factor the diagonal block and solve for the panel below it
+        for (j = kb; j < kend; j++)
+        {
+            sum = c[j * d + j];
+            for (k = kb; k < j; k++)
+                sum = sum - c[j * d + k] * c[j * d + k];
+            if (sum <= 0.0)
+                return(-1);
+            c[j * d + j] = sqrt(sum);
+            for (i = j + 1; i < d; i++)
+            {
+                sum = c[i * d + j];
+                for (k = kb; k < j; k++)
+                    sum = sum - c[i * d + k] * c[j * d + k];
+                c[i * d + j] = sum / c[j * d + j];
+            }
+        }
+
+        // Update the trailing lower triangle with the panel, by blocks
+        for (ib = kend; ib < d; ib = ib + MVN_BLOCK)
+        {
+            iend = ib + MVN_BLOCK;
+            if (iend > d)
+                iend = d;
+            for (jb = kend; jb <= ib; jb = jb + MVN_BLOCK)
+            {
+                jend = jb + MVN_BLOCK;
+                if (jend > d)
+                    jend = d;
+                for (i = ib; i < iend; i++)
+                    for (j = jb; (j < jend) && (j <= i); j++)
+                    {
+                        sum = 0.0;
+                        for (k = kb; k < kend; k++)
+                            sum = sum + c[i * d + k] * c[j * d + k];
+                        c[i * d + j] = c[i * d + j] - sum;
+                    }
+            }
+        }
+    }
+
+    // Transpose L into the upper triangle and zero the lower triangle
+    for (i = 0; i < d; i++)
+        for (j = 0; j < i; j++)
+        {
+            c[j * d + i] = c[i * d + j];
+            c[i * d + j] = 0.0;
+        }
+
+    return(0);
+}
+
+//===========================================================================
+//=  Function to generate a batch of correlated normal random vectors       =
+//=    - Input: Output and work buffers x and z (num * d each), number of   =
+//=      vectors, L^T from cholesky(), mean vector, and dimension           =
+//=    - Output: Fills x with num vectors (by rows) as X = Z * L^T + mean   =
+//=    - The product is done in MVN_BLOCK x MVN_BLOCK tiles of L^T with a   =
+//=      unit stride inner loop that the compiler can vectorize             =
+//===========================================================================
+void mvn_fill(double *x, double *z, int num, double *lt, double *mean,
+  int d)
+{
+    int      kb, kend;              // Block of rows of L^T
+    int      ib, iend;              // Block of columns of L^T
+    double   zk;                    // One iid normal value
+    double   *xv;                   // Row of x for one vector
+    int      i, k, v;               // Loop counters
+
+    // Generate the iid normal(0, 1) block and start x at the mean
+    for (i = 0; i < num * d; i++)
+        z[i] = norm_zig(0.0, 1.0);
+    for (v = 0; v < num; v++)
+        memcpy(&x[v * d], mean, d * sizeof(double));
+
+    // Blocked triangular product x += z * L^T
+    for (kb = 0; kb < d; kb = kb + MVN_BLOCK)
+    {
+        kend = kb + MVN_BLOCK;
+        if (kend > d)
+            kend = d;
+        for (ib = kb; ib < d; ib = ib + MVN_BLOCK)
+        {
+            iend = ib + MVN_BLOCK;
+            if (iend > d)
+                iend = d;
+            for (v = 0; v < num; v++)
+            {
+                xv = &x[v * d];
+                for (k = kb; k < kend; k++)
+                {
+                    zk = z[v * d + k];
+                    for (i = (k > ib) ? k : ib; i < iend; i++)
+                        xv[i] = xv[i] + zk * lt[k * d + i];
+                }
+            }
+        }
+    }
+}
+
+//===========================================================================
+//=  Function to generate normally distributed random variable using the    =
+//=  Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat Method   =
+//=  for Generating Random Variables," Journal of Statistical Software,     =
+//=  Vol. 5, No. 8, 2000.                                                   =
+//=    - Input: mean and standard deviation                                 =
+//=    - Output: Returns with normally distributed random variable          =
+//=    - The layer tables are built on the first call only                  =
+//===========================================================================
+double norm_zig(double mean, double std_dev)
+{
+    static int    first = 1;        // Static first time flag
+    static double kn[ZIG_N];        // Fast path accept bounds for layers
+    static double wn[ZIG_N];        // Layer widths scaled by 1 / 2^30
+    static double fn[ZIG_N];        // Normal density at the layer edges
+    double   dn, tn, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    long     hz;                    // Signed 31-bit random integer
+    int      iz;                    // Layer index
+    double   x, y;                  // Normal(0, 1) rv and tail variable
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        dn = tn = ZIG_R;
+        q = ZIG_V / exp(-0.5 * dn * dn);
+        kn[0] = (dn / q) * ZIG_M;
+        kn[1] = 0.0;
+        wn[0] = q / ZIG_M;
+        wn[ZIG_N - 1] = dn / ZIG_M;
+        fn[0] = 1.0;
+        fn[ZIG_N - 1] = exp(-0.5 * dn * dn);
+        for (i = ZIG_N - 2; i >= 1; i--)
+        {
+            dn = sqrt(-2.0 * log(ZIG_V / dn + exp(-0.5 * dn * dn)));
+            kn[i + 1] = (dn / tn) * ZIG_M;
+            tn = dn;
+            fn[i] = exp(-0.5 * dn * dn);
+            wn[i] = dn / ZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (ZIG_N - 1));
+    hz = jz - (long) ZIG_M;
+    if (labs(hz) < kn[iz])
+        return((hz * wn[iz] * std_dev) + mean);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        x = hz * wn[iz];
+        if (iz == 0)
+        {
+            do
+            {
+                x = -log(rand_val(0)) / ZIG_R;
+                y = -log(rand_val(0));
+            }
+            while ((y + y) < (x * x));
+            x = (hz > 0) ? (ZIG_R + x) : (-ZIG_R - x);
+            break;
+        }
+        if ((fn[iz] + rand_val(0) * (fn[iz - 1] - fn[iz])) < exp(-0.5 * x * x))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (ZIG_N - 1));
+        hz = jz - (long) ZIG_M;
+        if (labs(hz) < kn[iz])
+        {
+            x = hz * wn[iz];
+            break;
+        }
+    }
+
+    // Adjust x value for specified mean and variance
+    return((x * std_dev) + mean);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
+//=========================================================================
+//= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
+//=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
+//=   - With x seeded to 1 the 10000th x value should be 1043618065       =
+//=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
+//=     John Wiley & Sons, 1991. (Page 443, Figure 26.2)                  =
+//=========================================================================
+double rand_val(int seed)
+{
+    const long  a =      16807;  // Multiplier
+    const long  m = 2147483647;  // Modulus
+    const long  q =     127773;  // m div a
+    const long  r =       2836;  // m mod a
+    static long x;               // Random int value
+    long        x_div_q;         // x divided by q
+    long        x_mod_q;         // x modulo q
+    long        x_new;           // New x value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0.0);
+    }
+
+    // RNG using integer arithmetic
+    x_div_q = x / q;
+    x_mod_q = x % q;
+    x_new = (a * x_mod_q) - (r * x_div_q);
+    if (x_new > 0)
+        x = x_new;
+    else
+        x = x_new + m;
+
+    // Return a random value between 0.0 and 1.0
+    return((double) x / m);
+}
@@ -0,0 +1,353 @@
+//==================================================== file = gennhpp.c =====
+//=  Program to generate non-homogeneous Poisson interarrival times         =
+//===========================================================================
+//=  Notes: 1) Writes to a user specified output file                       =
+//=             * File format is <interarrival time delta>                  =
+//=         2) Generates samples for user specified time period             =
+//=         3) The rate profile repeats with its period and is either       =
+//=             * Piecewise constant, read from a user specified file.      =
+//=               The file format is the number of segments, then one       =
+//=               <length in seconds> <rate> pair per segment.  Arrivals    =
+//=               are generated by inversion of the cumulative rate, so     =
+//=               every candidate is accepted.                              =
+//=             * Sinusoidal, lambda(t) = a + b * sin(2 * pi * t / period)  =
+//=               with 0 <= b <= a.  Arrivals are generated by thinning     =
+//=               against a piecewise constant majorant with NHPP_SEG       =
+//=               segments per period, so acceptance is near 100%.          =
+//=         4) The current segment is kept between arrivals and whole       =
+//=            periods are skipped in one step, so work is linear in the    =
+//=            number of arrivals plus segments crossed                     =
+//=-------------------------------------------------------------------------=
+//= Example rate profile file ("rate.dat", a day in four 6-hour segments):  =
+//=                                                                         =
+//=   4                                                                     =
+//=   21600.0  1.0                                                          =
+//=   21600.0  10.0                                                         =
+//=   21600.0  20.0                                                         =
+//=   21600.0  5.0                                                          =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ---------------------------------------- gennhpp.c -----              =
+//=   -  Program to generate non-homogeneous Poisson         -              =
+//=   -  interarrival times                                  -              =
+//=   --------------------------------------------------------              =
+//=   Output file name ===================================> output.dat      =
+//=   Random number seed =================================> 1               =
+//=   Rate profile (1 = file, 2 = sinusoid) ==============> 2               =
+//=   Mean rate in customers per second (a) ==============> 10.0            =
+//=   Amplitude of the rate (b <= a) =====================> 5.0             =
+//=   Period of the rate in seconds ======================> 86400.0         =
+//=   Time period to generate samples ====================> 172800.0        =
+//=   --------------------------------------------------------              =
+//=   -  Generating samples to file                          -              =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc gennhpp.c -lm, bcc32 gennhpp.c                              =
+//=-------------------------------------------------------------------------=
+//=  Execute: gennhpp                                                       =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from genexp.c and genipp.c)             =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <math.h>               // Needed for log(), sin(), and floor()
+
+//----- Defines -------------------------------------------------------------
+#define PI_D       3.14159265358979324  // Pi to double precision
+#define NHPP_SEG   1024         // Majorant segments per sinusoid period
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                  // NHPP sampler built by nhpp_init()
+{
+    int    num_seg;             // Number of segments per period
+    double *len;                // Length of each segment in seconds
+    double *rate;               // Rate (or majorant rate) of each segment
+    double period;              // Period of the profile in seconds
+    double cycle;               // Integrated rate over one period
+    int    thin;                // 1 = thin against lambda(t) (sinusoid)
+    double a, b;                // Sinusoid mean rate and amplitude
+    double t;                   // Time of the last arrival
+    int    k;                   // Segment of the last arrival
+    double seg_end;             // End time of segment k
+} nhpp_t;
+
+//----- Function prototypes -------------------------------------------------
+int    nhpp_init(nhpp_t *s);            // Sets up period and start state
+double nhpp_next(nhpp_t *s);            // Returns the next arrival time
+double sin_rate(nhpp_t *s, double t);   // Sinusoid rate at time t
+double rand_val(int seed);              // Jain's RNG
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_in;                // File pointer to rate profile file
+    FILE     *fp_out;               // File pointer to output file
+    char     instring[256];         // Input string
+    nhpp_t   nhpp;                  // NHPP sampler
+    double   t0, t1;                // Start and end times of a segment
+    double   time_period;           // Time period to generate samples
+    double   last_time;             // Time of the last arrival
+    double   arr_time;              // Time of the next arrival
+    int      i;                     // Loop counter
+
+    // Output banner
+    printf("---------------------------------------- gennhpp.c ----- \n");
+    printf("-  Program to generate non-homogeneous Poisson         - \n");
+    printf("-  interarrival times                                  - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for output filename and then create/open the file
+    printf("Output file name ===================================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Prompt for random number seed and then use it
+    printf("Random number seed =================================> ");
+    scanf("%s", instring);
+    rand_val((int) atoi(instring));
+
+    // Prompt for the kind of rate profile
+    printf("Rate profile (1 = file, 2 = sinusoid) ==============> ");
+    scanf("%s", instring);
+    nhpp.thin = (atoi(instring) == 2);
+
+    // Read the piecewise constant profile from a file
+    if (nhpp.thin == 0)
+    {
+        printf("Rate profile file name =============================> ");
+        scanf("%s", instring);
+        fp_in = fopen(instring, "r");
+        if (fp_in == NULL)
+        {
+            printf("ERROR in opening rate profile file (%s) \n", instring);
+            exit(1);
+        }
+        if ((fscanf(fp_in, "%d", &nhpp.num_seg) != 1) || (nhpp.num_seg < 1))
+        {
+            printf("ERROR in reading number of segments from profile file \n");
+            exit(1);
+        }
+        nhpp.len = (double *) malloc(nhpp.num_seg * sizeof(double));
+        nhpp.rate = (double *) malloc(nhpp.num_seg * sizeof(double));
+        if ((nhpp.len == NULL) || (nhpp.rate == NULL))
+        {
+            printf("ERROR - could not malloc space for arrays \n");
+            exit(1);
+        }
+        for (i = 0; i < nhpp.num_seg; i++)
+            if (fscanf(fp_in, "%lf %lf", &nhpp.len[i], &nhpp.rate[i]) != 2)
+            {
+                printf("ERROR in reading segment %d from profile file \n", i);
+                exit(1);
+            }
+        fclose(fp_in);
+    }
+
+    // Build the piecewise constant majorant of the sinusoid
+    //  - The maximum over a segment is at an end point unless the
+    //    segment holds the peak at one quarter of the period
+    else
+    {
+        printf("Mean rate in customers per second (a) ==============> ");
+        scanf("%s", instring);
+        nhpp.a = atof(instring);
+        printf("Amplitude of the rate (b <= a) =====================> ");
+        scanf("%s", instring);
+        nhpp.b = atof(instring);
+        printf("Period of the rate in seconds ======================> ");
+        scanf("%s", instring);
+        nhpp.period = atof(instring);
+        if ((nhpp.b < 0.0) || (nhpp.b > nhpp.a) || (nhpp.period <= 0.0))
+        {
+            printf("ERROR - need 0 <= b <= a and a period greater than 0 \n");
+            exit(1);
+        }
+        nhpp.num_seg = NHPP_SEG;
+        nhpp.len = (double *) malloc(nhpp.num_seg * sizeof(double));
+        nhpp.rate = (double *) malloc(nhpp.num_seg * sizeof(double));
+        if ((nhpp.len == NULL) || (nhpp.rate == NULL))
+        {
+            printf("ERROR - could not malloc space for arrays \n");
+            exit(1);
+        }
+        for (i = 0; i < nhpp.num_seg; i++)
+        {
+            t0 = nhpp.period * i / nhpp.num_seg;
+            t1 = nhpp.period * (i + 1) / nhpp.num_seg;
+            nhpp.len[i] = t1 - t0;
+            nhpp.rate[i] = sin_rate(&nhpp, t0);
+            if (sin_rate(&nhpp, t1) > nhpp.rate[i])
+                nhpp.rate[i] = sin_rate(&nhpp, t1);
+            if ((t0 <= 0.25 * nhpp.period) && (0.25 * nhpp.period < t1))
+                nhpp.rate[i] = nhpp.a + nhpp.b;
+        }
+    }
+
+    // Prompt for time period (seconds) to generate samples
+    printf("Time period to generate samples ====================> ");
+    scanf("%s", instring);
+    time_period = atof(instring);
+
+    // Check the profile and set the start state
+    if (nhpp_init(&nhpp) != 0)
+    {
+        printf("ERROR - rate profile has a negative rate or no arrivals \n");
+        exit(1);
+    }
+
+    // Output message and generate interarrival times
+    printf("-------------------------------------------------------- \n");
+    printf("-  Generating samples to file                          - \n");
+    printf("-------------------------------------------------------- \n");
+    last_time = 0.0;
+    while (last_time < time_period)
+    {
+        arr_time = nhpp_next(&nhpp);
+        fprintf(fp_out, "%f \n", arr_time - last_time);
+        last_time = arr_time;
+    }
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+}
+
+//===========================================================================
+//=  Function to check a rate profile and set the start state               =
+//=    - Input:  Sampler with num_seg, len[], rate[], and thin set          =
+//=    - Output: Sets the period, the integrated rate per period, and the   =
+//=      start state (time 0 in segment 0) and returns 0, or returns -1 if  =
+//=      a rate or length is negative or there are no arrivals              =
+//===========================================================================
+int nhpp_init(nhpp_t *s)
+{
+    int      i;                     // Loop counter
+
+    s->period = 0.0;
+    s->cycle = 0.0;
+    for (i = 0; i < s->num_seg; i++)
+    {
+        if ((s->len[i] < 0.0) || (s->rate[i] < 0.0))
+            return(-1);
+        s->period = s->period + s->len[i];
+        s->cycle = s->cycle + s->len[i] * s->rate[i];
+    }
+    if (s->cycle <= 0.0)
+        return(-1);
+
+    s->t = 0.0;
+    s->k = 0;
+    s->seg_end = s->len[0];
+    return(0);
+}
+
+//===========================================================================
+//=  Function to generate the next NHPP arrival time                        =
+//=    - Input:  Sampler from nhpp_init()                                   =
+//=    - Output: Returns the time of the next arrival                       =
+//=    - An exponential(1) amount of integrated rate is spent segment by    =
+//=      segment from the last arrival (whole periods in one step), which   =
+//=      inverts the cumulative rate.  For the sinusoid the rate is the     =
+//=      majorant and the candidate is kept with probability                =
+//=      lambda(t) / majorant.                                              =
+//===========================================================================
+double nhpp_next(nhpp_t *s)
+{
+    double   e;                     // Integrated rate left to spend
+    double   n;                     // Number of whole periods to skip
+    double   area;                  // Integrated rate left in the segment
+
+    while (1)
+    {
+        // Pull an exponential(1) (rand_val() never returns 0 or 1)
+        e = -log(rand_val(0));
+
+        // Skip whole periods
+        if (e >= s->cycle)
+        {
+            n = floor(e / s->cycle);
+            e = e - n * s->cycle;
+            s->t = s->t + n * s->period;
+            s->seg_end = s->seg_end + n * s->period;
+        }
+
+        // Spend the rest segment by segment
+        area = s->rate[s->k] * (s->seg_end - s->t);
+        while (area <= e)
+        {
+            e = e - area;
+            s->t = s->seg_end;
+            s->k = s->k + 1;
+            if (s->k == s->num_seg)
+                s->k = 0;
+            s->seg_end = s->t + s->len[s->k];
+            area = s->rate[s->k] * s->len[s->k];
+        }
+        s->t = s->t + e / s->rate[s->k];
+
+        // Accept (always for a piecewise constant profile)
+        if (s->thin == 0)
+            return(s->t);
+        if (rand_val(0) * s->rate[s->k] <= sin_rate(s, s->t))
+            return(s->t);
+    }
+}
+
+//===========================================================================
+//=  Function to return the sinusoid rate a + b * sin(2 * pi * t / period)  =
+//===========================================================================
+double sin_rate(nhpp_t *s, double t)
+{
+    return(s->a + s->b * sin(2.0 * PI_D * t / s->period));
+}
+
+//=========================================================================
+//= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
+//=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
+//=   - With x seeded to 1 the 10000th x value should be 1043618065       =
+//=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
+//=     John Wiley & Sons, 1991. (Page 443, Figure 26.2)                  =
+//=========================================================================
+double rand_val(int seed)
+{
+    const long  a =      16807;  // Multiplier
+    const long  m = 2147483647;  // Modulus
+    const long  q =     127773;  // m div a
+    const long  r =       2836;  // m mod a
+    static long x;               // Random int value
+    long        x_div_q;         // x divided by q
+    long        x_mod_q;         // x modulo q
+    long        x_new;           // New x value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0.0);
+    }
+
+    // RNG using integer arithmetic
+    x_div_q = x / q;
+    x_mod_q = x % q;
+    x_new = (a * x_mod_q) - (r * x_div_q);
+    if (x_new > 0)
+        x = x_new;
+    else
+        x = x_new + m;
+
+    // Return a random value between 0.0 and 1.0
+    return((double) x / m);
+}
@@ -5,6 +5,13 @@
 //=         2) Generates user specified number of samples                   =
 //=         3) Uses the Box-Muller method and only generates one of two     =
 //=            paired normal random variables.                              =
+//=         4) Optionally uses the Ziggurat method of Marsaglia and Tsang,  =
+//=            which needs one uniform and one table compare for about 99%  =
+//=            of samples.                                                  =
+//=         5) Optionally uses a batched Box-Muller method that keeps both  =
+//=            paired normal random variables and evaluates log(), sin(),   =
+//=            and cos() with in-line polynomials over blocks of uniforms.  =
+//=            The first of each pair matches the Box-Muller method.        =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -16,6 +23,7 @@
 //=   Random number seed =================================> 1               =
 //=   Mean ===============================================> 0               =
 //=   Standard deviation =================================> 1               =
+//=   Method (1 = Box-Muller, 2 = Ziggurat, 3 = Batch) ===> 1               =
 //=   Number of samples to generate ======================> 10              =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
@@ -53,14 +61,28 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for sqrt() and log()
+#include <string.h>             // Needed for memcpy()
+#include <math.h>               // Needed for sqrt(), log(), and exp()
 
 //----- Defines -------------------------------------------------------------
 #define PI         3.14159265   // The value of pi
+#define PI_D       3.14159265358979324  // Pi to double precision
+#define LN2_D      0.693147180559945309 // Natural log of 2
+#define NORM_BLOCK 256          // Number of Box-Muller pairs per batch
+#define ZIG_N      128          // Number of Ziggurat layers
+#define ZIG_R      3.442619855899       // Start of the right-most tail
+#define ZIG_V      9.91256303526217e-3  // Area of each Ziggurat layer
+#define ZIG_M      1073741824.0 // 2^30 scale for signed 31-bit integers
 
 //----- Function prototypes -------------------------------------------------
-double norm(double mean, double std_dev);  // Returns a normal rv
-double rand_val(int seed);                 // Jain's RNG
+double norm(double mean, double std_dev);      // Returns a normal rv
+double norm_zig(double mean, double std_dev);  // Ziggurat normal rv
+void   norm_fill(double *buf, int num, double mean, double std_dev);
+static double poly_log(double x);              // Polynomial log()
+static double poly_sin(double x);              // Polynomial sin() on +/-pi/2
+static double poly_cos(double x);              // Polynomial cos() on +/-pi/2
+long   rand_bits(void);                        // 31 random bits
+double rand_val(int seed);                     // Jain's RNG
 
 //===== Main program ========================================================
 void main(void)
@@ -70,7 +92,10 @@ void main(void)
     double   num_samples;           // Number of samples to generate
     double   mean, std_dev;         // Mean and standard deviation
     double   norm_rv;               // The adjusted normal rv
-    int      i;                     // Loop counter
+    double   buf[2 * NORM_BLOCK];   // Buffer of normal rvs for batch method
+    int      method;                // Method (1 = Box-Muller, 2 = Ziggurat)
+    int      n;                     // Number of rvs in buffer
+    int      i, j;                  // Loop counters
 
     // Output banner
     printf("---------------------------------------- gennorm.c ----- \n");
@@ -103,6 +128,11 @@ void main(void)
     scanf("%s", instring);
     std_dev = atof(instring);
 
+    // Prompt for the generation method
+    printf("Method (1 = Box-Muller, 2 = Ziggurat, 3 = Batch) ===> ");
+    scanf("%s", instring);
+    method = atoi(instring);
+
     // Prompt for number of samples to generate
     printf("Number of samples to generate ======================> ");
     scanf("%s", instring);
@@ -112,10 +142,26 @@ void main(void)
     printf("-------------------------------------------------------- \n");
     printf("-  Generating samples to file                          - \n");
     printf("-------------------------------------------------------- \n");
-    for (i = 0; i < num_samples; i++)
+    if (method == 3)
+    {
+        // Generate a buffer of normally distributed rvs at a time
+        for (i = 0; i < num_samples; i = i + n)
+        {
+            n = 2 * NORM_BLOCK;
+            if (n > num_samples - i)
+                n = num_samples - i;
+            norm_fill(buf, n, mean, std_dev);
+            for (j = 0; j < n; j++)
+                fprintf(fp_out, "%f \n", buf[j]);
+        }
+    }
+    else for (i = 0; i < num_samples; i++)
     {
         // Generate a normally distributed rv
-        norm_rv = norm(mean, std_dev);
+        if (method == 2)
+            norm_rv = norm_zig(mean, std_dev);
+        else
+            norm_rv = norm(mean, std_dev);
 
         // Output the norm_rv value
         fprintf(fp_out, "%f \n", norm_rv);
@@ -163,6 +209,211 @@ double norm(double mean, double std_dev)
     return(norm_rv);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with normally distributed random variables   =
+//=  using the Box-Muller method                                            =
+//=    - Input: buffer, number of rvs, mean and standard deviation          =
+//=    - Output: Fills buf[0] to buf[num - 1] with normal rvs               =
+//=    - Uniforms are pulled in the same order as norm() and both paired    =
+//=      rvs are kept, so buf[0], buf[2], ... match successive norm() calls =
+//=    - The transform loop has no calls or branches so that the compiler   =
+//=      can vectorize it (e.g., gcc -O3 -mavx2 -fno-math-errno)            =
+//===========================================================================
+void norm_fill(double *buf, int num, double mean, double std_dev)
+{
+    double   u[NORM_BLOCK];         // Uniforms for r
+    double   theta[NORM_BLOCK];     // Uniform angles
+    double   x[2 * NORM_BLOCK];     // Paired normal rvs for one block
+    double   r, t, s, c;            // Variables for Box-Muller method
+    int      num_pairs;             // Number of pairs in this block
+    int      i, j;                  // Loop counters
+
+    for (i = 0; i < num; i = i + 2 * num_pairs)
+    {
+        num_pairs = (num - i + 1) / 2;
+        if (num_pairs > NORM_BLOCK)
+            num_pairs = NORM_BLOCK;
+
+        // Pull the uniforms (rand_val() never returns 0.0 or 1.0)
+        for (j = 0; j < num_pairs; j++)
+        {
+            u[j] = rand_val(0);
+            theta[j] = 2.0 * PI * rand_val(0);
+        }
+
+        // Transform both halves of each pair using the half angle t / 2,
+        // where theta = t + pi so that cos(theta) = -cos(t)
+        for (j = 0; j < num_pairs; j++)
+        {
+            r = sqrt(-2.0 * poly_log(u[j]));
+            t = 0.5 * (theta[j] - PI_D);
+            s = poly_sin(t);
+            c = poly_cos(t);
+            x[2 * j] = (r * (s * s - c * c) * std_dev) + mean;
+            x[2 * j + 1] = (r * (-2.0 * s * c) * std_dev) + mean;
+        }
+
+        // Copy out the block (drops the last rv when num is odd)
+        if (2 * num_pairs > num - i)
+            memcpy(&buf[i], x, (num - i) * sizeof(double));
+        else
+            memcpy(&buf[i], x, 2 * num_pairs * sizeof(double));
+    }
+}
+
+//===========================================================================
+//=  Function to compute log(x) for x > 0 without calling libm              =
+//=    - Splits x into 2^e * m with sqrt(1/2) <= m < sqrt(2) and then uses  =
+//=      log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172      =
+//=    - Accurate to within a few ulps for normal (non-denormal) x          =
+//===========================================================================
+static double poly_log(double x)
+{
+    unsigned long long bits;      // Bits of x
+    unsigned long long k;         // Biased exponent of x / sqrt(1/2)
+    unsigned long long ebits;     // Bits of 2^52 plus k
+    double    e, m, s, s2;        // Exponent, mantissa, and atanh variables
+
+    // Split x into 2^e * m with integer operations only (no compares and
+    // no integer to double conversion so that loops vectorize)
+    memcpy(&bits, &x, sizeof(bits));
+    k = (bits - 0x3fe6a09e667f3bcdULL + 0x4000000000000000ULL) >> 52;
+    ebits = k | 0x4330000000000000ULL;
+    memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1024.0);
+    bits = bits - (k << 52) + 0x4000000000000000ULL;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Series for atanh(s) up to the s^17 term
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    return((e * LN2_D) + 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5
+        + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 * (1.0 / 11 + s2 * (1.0 / 13
+        + s2 * (1.0 / 15 + s2 * (1.0 / 17))))))))));
+}
+
+//===========================================================================
+//=  Function to compute sin(x) for -pi/2 <= x <= pi/2 without calling libm =
+//=    - Taylor series up to the x^21 term                                  =
+//===========================================================================
+static double poly_sin(double x)
+{
+    double x2 = x * x;            // x squared
+
+    return(x * (1.0 + x2 * (-1.0 / 6 + x2 * (1.0 / 120 + x2 * (-1.0 / 5040
+        + x2 * (1.0 / 362880 + x2 * (-1.0 / 39916800 + x2 * (1.0 / 6227020800.0
+        + x2 * (-1.0 / 1307674368000.0 + x2 * (1.0 / 355687428096000.0
+        + x2 * (-1.0 / 121645100408832000.0
+        + x2 * (1.0 / 51090942171709440000.0))))))))))));
+}
+
+//===========================================================================
+//=  Function to compute cos(x) for -pi/2 <= x <= pi/2 without calling libm =
+//=    - Taylor series up to the x^20 term                                  =
+//===========================================================================
+static double poly_cos(double x)
+{
+    double x2 = x * x;            // x squared
+
+    return(1.0 + x2 * (-1.0 / 2 + x2 * (1.0 / 24 + x2 * (-1.0 / 720
+        + x2 * (1.0 / 40320 + x2 * (-1.0 / 3628800 + x2 * (1.0 / 479001600
+        + x2 * (-1.0 / 87178291200.0 + x2 * (1.0 / 20922789888000.0
+        + x2 * (-1.0 / 6402373705728000.0
+        + x2 * (1.0 / 2432902008176640000.0)))))))))));
+}
+
+//===========================================================================
+//=  Function to generate normally distributed random variable using the    =
+//=  Ziggurat method from G. Marsaglia and W. Tsang, "The Ziggurat Method   =
+//=  for Generating Random Variables," Journal of Statistical Software,     =
+//=  Vol. 5, No. 8, 2000.                                                   =
+//=    - Input: mean and standard deviation                                 =
+//=    - Output: Returns with normally distributed random variable          =
+//=    - The layer tables are built on the first call only                  =
+//===========================================================================
+double norm_zig(double mean, double std_dev)
+{
+    static int    first = 1;        // Static first time flag
+    static double kn[ZIG_N];        // Fast path accept bounds for layers
+    static double wn[ZIG_N];        // Layer widths scaled by 1 / 2^30
+    static double fn[ZIG_N];        // Normal density at the layer edges
+    double   dn, tn, q;             // Variables for building the tables
+    long     jz;                    // Unsigned 31-bit random integer
+    long     hz;                    // Signed 31-bit random integer
+    int      iz;                    // Layer index
+    double   x, y;                  // Normal(0, 1) rv and tail variable
+    int      i;                     // Loop counter
+
+    // Build the layer tables on first call only
+    if (first == 1)
+    {
+        dn = tn = ZIG_R;
+        q = ZIG_V / exp(-0.5 * dn * dn);
+        kn[0] = (dn / q) * ZIG_M;
+        kn[1] = 0.0;
+        wn[0] = q / ZIG_M;
+        wn[ZIG_N - 1] = dn / ZIG_M;
+        fn[0] = 1.0;
+        fn[ZIG_N - 1] = exp(-0.5 * dn * dn);
+        for (i = ZIG_N - 2; i >= 1; i--)
+        {
+            dn = sqrt(-2.0 * log(ZIG_V / dn + exp(-0.5 * dn * dn)));
+            kn[i + 1] = (dn / tn) * ZIG_M;
+            tn = dn;
+            fn[i] = exp(-0.5 * dn * dn);
+            wn[i] = dn / ZIG_M;
+        }
+        first = 0;
+    }
+
+    // Fast path -- accept if inside the rectangle of a random layer
+    jz = rand_bits();
+    iz = (int) (jz & (ZIG_N - 1));
+    hz = jz - (long) ZIG_M;
+    if (labs(hz) < kn[iz])
+        return((hz * wn[iz] * std_dev) + mean);
+
+    // Slow path -- tail for the base layer, wedge test for the others
+    while (1)
+    {
+        x = hz * wn[iz];
+        if (iz == 0)
+        {
+            do
+            {
+                x = -log(rand_val(0)) / ZIG_R;
+                y = -log(rand_val(0));
+            }
+            while ((y + y) < (x * x));
+            x = (hz > 0) ? (ZIG_R + x) : (-ZIG_R - x);
+            break;
+        }
+        if ((fn[iz] + rand_val(0) * (fn[iz - 1] - fn[iz])) < exp(-0.5 * x * x))
+            break;
+
+        // Rejected, so try the fast path again with a new layer
+        jz = rand_bits();
+        iz = (int) (jz & (ZIG_N - 1));
+        hz = jz - (long) ZIG_M;
+        if (labs(hz) < kn[iz])
+        {
+            x = hz * wn[iz];
+            break;
+        }
+    }
+
+    // Adjust x value for specified mean and variance
+    return((x * std_dev) + mean);
+}
+
+//===========================================================================
+//=  Function to return 31 random bits (0 <= value < 2^31) from Jain's RNG  =
+//===========================================================================
+long rand_bits(void)
+{
+    return((long) (rand_val(0) * 2147483648.0));
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -9,6 +9,8 @@
 //=         3) See M. Crovella and M. Harchol-Balter, and C. Murta, "Task   =
 //=            Assignment in a Distributed System: Improving Performance    =
 //=            by Unbalancing Load," BUCS-TR-1997-018, October 1997.        =
+//=         4) A bpareto_t sampler holds k, (k/p)^a - 1, and -1/a so that   =
+//=            each sample needs one pow() call                             =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -58,10 +60,31 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>            // Needed for printf()
 #include <stdlib.h>           // Needed for exit() and ato*()
+#include <string.h>           // Needed for memcpy()
 #include <math.h>             // Needed for log() and pow()
 
+//----- Defines -------------------------------------------------------------
+#define PAR_BLOCK  1024       // Number of values generated per batch
+#define LN2_D      0.693147180559945309 // Natural log of 2
+#define LN2_HI     6.93147180369123816490e-01 // High part of ln(2)
+#define LN2_LO     1.90821492927058770002e-10 // Low part of ln(2)
+#define INV_LN2_D  1.44269504088896338700     // 1 / ln(2)
+#define EXP_MAX_D  708.0      // Largest |x| that poly_exp() handles
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                // Bounded Pareto sampler built by bpareto_init()
+{
+    double k;                 // Lower bound k
+    double c;                 // (k / p)^a - 1
+    double neg_inv_a;         // -1 / a
+} bpareto_t;
+
 //----- Function prototypes -------------------------------------------------
-double bpareto(double a, double k, double p); // Returns a bounded Pareto rv
+void   bpareto_init(bpareto_t *s, double a, double k, double p);
+double bpareto_sample(bpareto_t *s);          // Returns a bounded Pareto rv
+void   bpareto_fill(bpareto_t *s, double *buf, int num); // Batch of rvs
+static double poly_log(double x);     // Polynomial log() (static so
+static double poly_exp(double x);     // that both inline in loops)
 double rand_val(int seed);                    // Jain's RNG
 
 //===== Main program ========================================================
@@ -72,9 +95,11 @@ void main(void)
     double a;                   // Pareto alpha value
     double k;                   // Pareto k value
     double p;                   // Pareto p value
-    double pareto_rv;           // Pareto random variable
+    bpareto_t sampler;          // Bounded Pareto sampler
+    double pareto_rv[PAR_BLOCK];  // Batch of Pareto random variables
     int    num_values;          // Number of values
-    int    i;                   // Loop counter
+    int    num_block;           // Number of values in this batch
+    int    i, j;                // Loop counters
 
     //Output banner
     printf("---------------------------------------- genpar2.c ----- \n");
@@ -124,10 +149,15 @@ void main(void)
     printf("-    * k     = %f                                \n", k);
     printf("-    * p     = %f                                \n", p);
     printf("-------------------------------------------------------- \n");
-    for (i = 0; i < num_values; i++)
+    bpareto_init(&sampler, a, k, p);
+    for (i = 0; i < num_values; i = i + num_block)
     {
-        pareto_rv = bpareto(a, k, p);
-        fprintf(fp, "%f \n", pareto_rv);
+        num_block = PAR_BLOCK;
+        if (num_block > num_values - i)
+            num_block = num_values - i;
+        bpareto_fill(&sampler, pareto_rv, num_block);
+        for (j = 0; j < num_block; j++)
+            fprintf(fp, "%f \n", pareto_rv[j]);
     }
 
     //Output message and close the outout file
@@ -137,12 +167,26 @@ void main(void)
     fclose(fp);
 }
 
+//===========================================================================
+//=  Function to build a bounded Pareto sampler                             =
+//=    - Input:  Sampler, a, k, and p                                       =
+//=    - Output: Fills in the constants of the sampler                      =
+//===========================================================================
+void bpareto_init(bpareto_t *s, double a, double k, double p)
+{
+    s->k = k;
+    s->c = pow((k / p), a) - 1.0;
+    s->neg_inv_a = -1.0 / a;
+}
+
 //===========================================================================
 //=  Function to generate bounded Pareto distributed RVs using              =
-//=    - Input:  a, k, and p                                                =
+//=    - Input:  Sampler from bpareto_init()                                =
 //=    - Output: Returns with bounded Pareto RV                             =
+//=    - Inversion (k^a / (z*(k/p)^a - z + 1))^(1/a) is rewritten as        =
+//=      k * (1 + z*c)^(-1/a) with c = (k/p)^a - 1                          =
 //===========================================================================
-double bpareto(double a, double k, double p)
+double bpareto_sample(bpareto_t *s)
 {
     double z;     // Uniform random number from 0 to 1
     double rv;    // RV to be returned
@@ -155,11 +199,109 @@ double bpareto(double a, double k, double p)
     while ((z == 0) || (z == 1));
 
     // Generate the bounded Pareto rv using the inversion method
-    rv = pow((pow(k, a) / (z * pow((k / p), a) - z + 1)), (1.0 / a));
+    rv = s->k * pow(1.0 + z * s->c, s->neg_inv_a);
 
     return(rv);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with bounded Pareto RVs                      =
+//=    - Input:  Sampler from bpareto_init(), buffer, and number of values  =
+//=    - Output: Fills buf[0] to buf[num - 1] with bounded Pareto RVs       =
+//=    - Uniforms are pulled in the same order as bpareto_sample() (as      =
+//=      rand_val() never returns 0 or 1) and then transformed as           =
+//=      k * exp(-log(1 + z*c) / a) in a loop that the compiler can         =
+//=      vectorize                                                          =
+//===========================================================================
+void bpareto_fill(bpareto_t *s, double *buf, int num)
+{
+    double k = s->k;                  // Local copies so that buf[] cannot
+    double c = s->c;                  // alias them in the loop below
+    double neg_inv_a = s->neg_inv_a;
+    int    big;   // Some exponent is out of poly_exp()'s range
+    int    i;     // Loop counter
+
+    // Pull the uniform RVs (0 < z < 1)
+    for (i = 0; i < num; i++)
+        buf[i] = rand_val(0);
+
+    // Generate the bounded Pareto rvs using the inversion method (as two
+    // loops so that each polynomial is inlined and the loops vectorize)
+    for (i = 0; i < num; i++)
+        buf[i] = neg_inv_a * poly_log(1.0 + buf[i] * c);
+
+    // poly_exp() only covers |x| <= EXP_MAX_D.  The exponent lies between
+    // 0 and -log(1 + c) / a, so a range that is too wide uses exp() instead.
+    big = (fabs(neg_inv_a * log(1.0 + c)) > EXP_MAX_D);
+    if (big)
+        for (i = 0; i < num; i++)
+            buf[i] = k * exp(buf[i]);
+    else
+        for (i = 0; i < num; i++)
+            buf[i] = k * poly_exp(buf[i]);
+}
+
+//===========================================================================
+//=  Function to compute log(x) for x > 0 without calling libm              =
+//=    - Splits x into 2^e * m with sqrt(1/2) <= m < sqrt(2) and then uses  =
+//=      log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172      =
+//=    - Accurate to within a few ulps for normal (non-denormal) x          =
+//===========================================================================
+static double poly_log(double x)
+{
+    unsigned long long bits;      // Bits of x
+    unsigned long long k;         // Biased exponent of x / sqrt(1/2)
+    unsigned long long ebits;     // Bits of 2^52 plus k
+    double    e, m, s, s2;        // Exponent, mantissa, and atanh variables
+
+    // Split x into 2^e * m with integer operations only (no compares and
+    // no integer to double conversion so that loops vectorize)
+    memcpy(&bits, &x, sizeof(bits));
+    k = (bits - 0x3fe6a09e667f3bcdULL + 0x4000000000000000ULL) >> 52;
+    ebits = k | 0x4330000000000000ULL;
+    memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1024.0);
+    bits = bits - (k << 52) + 0x4000000000000000ULL;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Series for atanh(s) up to the s^17 term
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    return((e * LN2_D) + 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5
+        + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 * (1.0 / 11 + s2 * (1.0 / 13
+        + s2 * (1.0 / 15 + s2 * (1.0 / 17))))))))));
+}
+
+//===========================================================================
+//=  Function to compute exp(x) for |x| < 708 without calling libm          =
+//=    - Splits x into n * ln(2) + r with |r| <= ln(2) / 2 and then uses    =
+//=      the Taylor series for exp(r) up to the r^13 term                   =
+//=    - Rounds n and builds 2^n with integer operations only (no compares  =
+//=      and no integer to double conversion so that loops vectorize)       =
+//=    - Callers must keep |x| <= EXP_MAX_D (larger x gives garbage bits)   =
+//===========================================================================
+static double poly_exp(double x)
+{
+    unsigned long long bits;      // Bits of n + 1.5 * 2^52, then of 2^n
+    double    n, r, scale;        // x = n * ln(2) + r and scale = 2^n
+
+    // Round x / ln(2) to the nearest integer by adding 1.5 * 2^52
+    n = x * INV_LN2_D + 6755399441055744.0;
+    memcpy(&bits, &n, sizeof(bits));
+    n = n - 6755399441055744.0;
+    bits = (bits + 1023) << 52;
+    memcpy(&scale, &bits, sizeof(scale));
+
+    // Reduce using ln(2) split in two parts for accuracy
+    r = (x - n * LN2_HI) - n * LN2_LO;
+
+    return(scale * (1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6
+        + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040
+        + r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800
+        + r * (1.0 / 39916800 + r * (1.0 / 479001600
+        + r * (1.0 / 6227020800.0)))))))))))))));
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -8,6 +8,10 @@
 //=            Cost for Searching for Objects in Multiple-Server Networks," =
 //=            Proceedings of the International Performance Computing and   =
 //=            Communications Conference, pp. 143-149, April 2005.          =
+//=         4) The CDF is (K + j - 1) / (N + K - 1) for j = 1 to N, so the  =
+//=            inverse is j = floor(z * (N + K - 1)) - K + 2 (at least 1).  =
+//=            Values are generated in batches with peak_fill() in O(1)     =
+//=            time each.                                                   =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -55,8 +59,12 @@
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
 
+//----- Defines -------------------------------------------------------------
+#define PEAK_BLOCK     1024     // Number of values generated per batch
+
 //----- Function prototypes -------------------------------------------------
 int    peak(int N, int K);      // Returns a peaked RV
+void   peak_fill(int *buf, int num, int N, int K);  // Batch of peaked RVs
 double rand_valc(int seed);     // Jain's RNG to return 0 < z < 1
 
 //===== Main program ========================================================
@@ -67,9 +75,10 @@ void main(void)
     char     temp_string[256];    // Temporary string variable
     int      N;                   // N value
     int      K;                   // K value
-    int      peak_rv;             // Peaked random variable
+    int      peak_rv[PEAK_BLOCK]; // Batch of peaked random variables
     int      num_values;          // Number of values
-    int      i;                   // Loop counter
+    int      num_block;           // Number of values in this batch
+    int      i, j;                // Loop counters
 
     // Output banner
     printf("---------------------------------------- genpeak.c ----- \n");
@@ -112,10 +121,14 @@ void main(void)
     printf("-------------------------------------------------------- \n");
 
     // Generate and output interarrival times
-    for (i = 0; i < num_values; i++)
+    for (i = 0; i < num_values; i = i + num_block)
     {
-        peak_rv = peak(N, K);
-        fprintf(fp, "%d \n", peak_rv);
+        num_block = num_values - i;
+        if (num_block > PEAK_BLOCK)
+            num_block = PEAK_BLOCK;
+        peak_fill(peak_rv, num_block, N, K);
+        for (j = 0; j < num_block; j++)
+            fprintf(fp, "%d \n", peak_rv[j]);
     }
 
     //Output message and close the output file
@@ -134,27 +147,50 @@ int peak(int N, int K)
 {
     double z;                     // Uniform random number (0 < z < 1)
     int    peak_value;            // Computed peaked value to be returned
-    int    i;                     // Loop counter
 
     // Pull a uniform random value (0 < z < 1)
     z = rand_valc(0);
 
-    // Generate peak RV -- similar approach to an empirical distribution
-    if (z < ((double) K / (N + K - 1)))
+    // Generate peak RV by inverting the piecewise linear CDF
+    peak_value = (int) (z * (N + K - 1)) - K + 2;
+    if (peak_value < 1)
         peak_value = 1;
-    else
-    {
-        for (i = 1; i < N; i++)
-            if (z < ((double) (K + i) / (N + K - 1)))
-            {
-                peak_value = i + 1;
-                break;
-            }
-    }
+    if (peak_value > N)
+        peak_value = N;
 
     return(peak_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with peak distributed random variables       =
+//=    - Input:  Buffer, number of values, and N and K values               =
+//=    - Output: Fills buf[0] to buf[num - 1] with peaked values            =
+//=    - Uniforms are drawn first so that the inversion loop vectorizes     =
+//===========================================================================
+void peak_fill(int *buf, int num, int N, int K)
+{
+    double z[PEAK_BLOCK];         // Block of uniforms (0 < z < 1)
+    double span;                  // N + K - 1
+    int    j;                     // Peaked value
+    int    i, k, n;               // Loop counters and block size
+
+    span = N + K - 1;
+    for (k = 0; k < num; k = k + n)
+    {
+        n = num - k;
+        if (n > PEAK_BLOCK)
+            n = PEAK_BLOCK;
+        for (i = 0; i < n; i++)
+            z[i] = rand_valc(0);
+        for (i = 0; i < n; i++)
+        {
+            j = (int) (z[i] * span) - K + 2;
+            j = (j < 1) ? 1 : j;
+            buf[k + i] = (j > N) ? N : j;
+        }
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
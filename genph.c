@@ -0,0 +1,510 @@
+//====================================================== file = genph.c =====
+//=  Program to generate phase-type (PH) distributed random variables       =
+//===========================================================================
+//=  Notes: 1) Writes to a user specified output file                       =
+//=         2) Generates user specified number of values                    =
+//=         3) Reads the PH representation (alpha, T) from a user           =
+//=            specified file.  The file format is the number of phases m,  =
+//=            then the m initial probabilities alpha, then the m x m       =
+//=            sub-generator matrix T by rows.  The exit rate of phase i    =
+//=            is -(row sum of T for row i) and 1 - sum(alpha) is the       =
+//=            probability of a value of zero.                              =
+//=         4) Exponential, Erlang, hypoexponential, hyperexponential,      =
+//=            Coxian, and mixtures of Erlangs are all PH distributions,    =
+//=            so this one program covers all of them                       =
+//=         5) A value is the absorption time of the Markov chain.  Each    =
+//=            phase has an alias table over its next phases (and           =
+//=            absorption) so that each jump costs one uniform and one      =
+//=            table lookup.  Values are generated in batches with the      =
+//=            holding time log()s in one loop (in-line polynomial log()    =
+//=            that vectorizes) after the jump chains are walked.           =
+//=-------------------------------------------------------------------------=
+//= Example PH file ("ph.dat" for a hypoexponential with rates 1 and 2):    =
+//=                                                                         =
+//=   2                                                                     =
+//=   1.0   0.0                                                             =
+//=   -1.0  1.0                                                             =
+//=   0.0   -2.0                                                            =
+//=-------------------------------------------------------------------------=
+//= Example user input:                                                     =
+//=                                                                         =
+//=   ------------------------------------------ genph.c -----              =
+//=   -  Program to generate phase-type random variables     -              =
+//=   --------------------------------------------------------              =
+//=   Output file name ===================================> output.dat      =
+//=   Random number seed =================================> 1               =
+//=   PH file name =======================================> ph.dat          =
+//=   Number of values to generate =======================> 1000000         =
+//=   --------------------------------------------------------              =
+//=   -  Generating samples to file                          -              =
+//=   --------------------------------------------------------              =
+//=   --------------------------------------------------------              =
+//=   -  Done!                                                              =
+//=   --------------------------------------------------------              =
+//=-------------------------------------------------------------------------=
+//=  Build: gcc genph.c -lm, bcc32 genph.c                                  =
+//=-------------------------------------------------------------------------=
+//=  Execute: genph                                                         =
+//=-------------------------------------------------------------------------=
+//=  History: (10/18/26) - Genesis (from generl.c and genhyp1.c)            =
+//===========================================================================
+
+//----- Include files -------------------------------------------------------
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc(), and ato*()
+#include <string.h>             // Needed for memcpy()
+#include <math.h>               // Needed for log()
+
+//----- Defines -------------------------------------------------------------
+#define PH_BLOCK   1024         // Number of values generated per batch
+#define PH_EPS     1.0e-9       // Tolerance for row sums of T
+#define LN2_D      0.693147180559945309 // Natural log of 2
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                  // PH sampler built by ph_init()
+{
+    int    m;                   // Number of phases
+    double *mean;               // Mean holding time of each phase
+    double *prob;               // Alias probabilities, m + 1 rows of m + 1
+    int    *alias;              // Alias outcomes, m + 1 rows of m + 1
+    double *u;                  // Holding time uniforms for a batch
+    double *w;                  // Holding time means for a batch
+    int    num_work;            // Size of the u[] and w[] buffers
+    int    *count;              // Number of holding times of each value
+    int    num_count;           // Size of the count[] buffer
+} ph_t;
+
+//----- Function prototypes -------------------------------------------------
+int    ph_init(ph_t *ph, int m, double *alpha, double *t);  // Builds sampler
+void   ph_fill(ph_t *ph, double *buf, int num);  // Batch of PH rvs
+int    ph_next(ph_t *ph, int row);      // Next phase from an alias table
+void   ph_grow(ph_t *ph);               // Doubles the batch work buffers
+void   alias_init(double *p, int n, double *prob, int *alias);
+static double poly_log(double x);       // Polynomial log()
+double rand_val(int seed);              // Jain's RNG
+
+//===== Main program ========================================================
+void main(void)
+{
+    FILE     *fp_in;                // File pointer to PH file
+    FILE     *fp_out;               // File pointer to output file
+    char     instring[256];         // Input string
+    int      m;                     // Number of phases
+    double   *alpha;                // Initial probability vector
+    double   *t;                    // Sub-generator matrix (by rows)
+    ph_t     ph;                    // PH sampler
+    double   buf[PH_BLOCK];         // Batch of PH rvs
+    int      num_values;            // Number of values to generate
+    int      n;                     // Number of values in this batch
+    int      i, j;                  // Loop counters
+
+    // Output banner
+    printf("------------------------------------------ genph.c ----- \n");
+    printf("-  Program to generate phase-type random variables     - \n");
+    printf("-------------------------------------------------------- \n");
+
+    // Prompt for output filename and then create/open the file
+    printf("Output file name ===================================> ");
+    scanf("%s", instring);
+    fp_out = fopen(instring, "w");
+    if (fp_out == NULL)
+    {
+        printf("ERROR in creating output file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Prompt for random number seed and then use it
+    printf("Random number seed =================================> ");
+    scanf("%s", instring);
+    rand_val((int) atoi(instring));
+
+    // Prompt for PH filename and then open the file
+    printf("PH file name =======================================> ");
+    scanf("%s", instring);
+    fp_in = fopen(instring, "r");
+    if (fp_in == NULL)
+    {
+        printf("ERROR in opening PH file (%s) \n", instring);
+        exit(1);
+    }
+
+    // Read the number of phases, alpha, and T
+    if ((fscanf(fp_in, "%d", &m) != 1) || (m < 1))
+    {
+        printf("ERROR in reading number of phases from PH file \n");
+        exit(1);
+    }
+    alpha = (double *) malloc(m * sizeof(double));
+    t = (double *) malloc(m * m * sizeof(double));
+    if ((alpha == NULL) || (t == NULL))
+    {
+        printf("ERROR - could not malloc space for arrays \n");
+        exit(1);
+    }
+    for (i = 0; i < m; i++)
+        if (fscanf(fp_in, "%lf", &alpha[i]) != 1)
+        {
+            printf("ERROR in reading alpha from PH file \n");
+            exit(1);
+        }
+    for (i = 0; i < m * m; i++)
+        if (fscanf(fp_in, "%lf", &t[i]) != 1)
+        {
+            printf("ERROR in reading T from PH file \n");
+            exit(1);
+        }
+    fclose(fp_in);
+
+    // Prompt for number of values to generate
+    printf("Number of values to generate =======================> ");
+    scanf("%s", instring);
+    num_values = atoi(instring);
+
+    // Build the alias tables once
+    if (ph_init(&ph, m, alpha, t) != 0)
+    {
+        printf("ERROR - alpha and T are not a valid PH representation \n");
+        exit(1);
+    }
+
+    // Output message and generate values
+    printf("-------------------------------------------------------- \n");
+    printf("-  Generating samples to file                          - \n");
+    printf("-------------------------------------------------------- \n");
+    for (i = 0; i < num_values; i = i + n)
+    {
+        n = PH_BLOCK;
+        if (n > num_values - i)
+            n = num_values - i;
+        ph_fill(&ph, buf, n);
+        for (j = 0; j < n; j++)
+            fprintf(fp_out, "%f \n", buf[j]);
+    }
+
+    // Output message and close the output file
+    printf("-------------------------------------------------------- \n");
+    printf("-  Done! \n");
+    printf("-------------------------------------------------------- \n");
+    fclose(fp_out);
+}
+
+//===========================================================================
+//=  Function to build a PH sampler                                         =
+//=    - Input:  Sampler, number of phases m, alpha, and T (by rows)        =
+//=    - Output: Fills in the sampler and returns 0, or returns -1 if       =
+//=      (alpha, T) is not valid or absorption is not certain               =
+//=    - Row i < m of the alias tables is the jump chain out of phase i     =
+//=      and row m is alpha.  Outcome m is absorption.                      =
+//===========================================================================
+int ph_init(ph_t *ph, int m, double *alpha, double *t)
+{
+    double   *p;                    // Probabilities for one row
+    int      *absorb;               // 1 if absorption is reachable
+    double   rate;                  // Total rate out of a phase
+    double   sum;                   // Sum of probabilities
+    int      changed;               // Flag for reachability updates
+    int      i, j;                  // Loop counters
+
+    ph->m = m;
+    ph->mean = (double *) malloc(m * sizeof(double));
+    ph->prob = (double *) malloc((m + 1) * (m + 1) * sizeof(double));
+    ph->alias = (int *) malloc((m + 1) * (m + 1) * sizeof(int));
+    ph->num_work = PH_BLOCK;
+    ph->u = (double *) malloc(ph->num_work * sizeof(double));
+    ph->w = (double *) malloc(ph->num_work * sizeof(double));
+    ph->num_count = PH_BLOCK;
+    ph->count = (int *) malloc(ph->num_count * sizeof(int));
+    p = (double *) malloc((m + 1) * sizeof(double));
+    absorb = (int *) malloc(m * sizeof(int));
+    if ((ph->mean == NULL) || (ph->prob == NULL) || (ph->alias == NULL) ||
+        (ph->u == NULL) || (ph->w == NULL) || (ph->count == NULL) ||
+        (p == NULL) || (absorb == NULL))
+    {
+        printf("ERROR - could not malloc space for alias tables \n");
+        exit(1);
+    }
+
+    // Jump chain out of each phase (exit rate is minus the row sum)
+    for (i = 0; i < m; i++)
+    {
+        rate = -t[i * m + i];
+        if (rate <= 0.0)
+            return(-1);
+        ph->mean[i] = 1.0 / rate;
+        sum = 0.0;
+        for (j = 0; j < m; j++)
+        {
+            p[j] = 0.0;
+            if (j == i)
+                continue;
+            if (t[i * m + j] < 0.0)
+                return(-1);
+            p[j] = t[i * m + j] / rate;
+            sum = sum + p[j];
+        }
+        if (sum > 1.0 + PH_EPS)
+            return(-1);
+        p[m] = (sum < 1.0) ? (1.0 - sum) : 0.0;
+        absorb[i] = (p[m] > 0.0);
+        alias_init(p, m + 1, &ph->prob[i * (m + 1)], &ph->alias[i * (m + 1)]);
+    }
+
+    // Initial phase from alpha (outcome m is a value of zero)
+    sum = 0.0;
+    for (j = 0; j < m; j++)
+    {
+        if (alpha[j] < 0.0)
+            return(-1);
+        p[j] = alpha[j];
+        sum = sum + p[j];
+    }
+    if (sum > 1.0 + PH_EPS)
+        return(-1);
+    p[m] = (sum < 1.0) ? (1.0 - sum) : 0.0;
+    alias_init(p, m + 1, &ph->prob[m * (m + 1)], &ph->alias[m * (m + 1)]);
+
+    // Check that absorption is reachable from every phase
+    do
+    {
+        changed = 0;
+        for (i = 0; i < m; i++)
+            for (j = 0; (j < m) && (absorb[i] == 0); j++)
+                if ((j != i) && (t[i * m + j] > 0.0) && (absorb[j] == 1))
+                {
+                    absorb[i] = 1;
+                    changed = 1;
+                }
+    }
+    while (changed == 1);
+    for (i = 0; i < m; i++)
+        if (absorb[i] == 0)
+            return(-1);
+
+    free(p);
+    free(absorb);
+    return(0);
+}
+
+//===========================================================================
+//=  Function to fill a buffer with PH random variables                     =
+//=    - Input:  Sampler from ph_init(), buffer, and number of values       =
+//=    - Output: Fills buf[0] to buf[num - 1] with PH rvs                   =
+//=    - The jump chains are walked first, saving the holding time          =
+//=      uniforms and means, then the log()s are done in one loop that the  =
+//=      compiler can vectorize, and then the holding times are summed per  =
+//=      value                                                              =
+//===========================================================================
+void ph_fill(ph_t *ph, double *buf, int num)
+{
+    int      num_hold;              // Number of holding times saved
+    int      state;                 // Current phase
+    int      i, j, k;               // Loop counters
+
+    // Grow the count buffer if needed
+    if (num > ph->num_count)
+    {
+        ph->num_count = num;
+        ph->count = (int *) realloc(ph->count, ph->num_count * sizeof(int));
+        if (ph->count == NULL)
+        {
+            printf("ERROR - could not realloc space for work buffers \n");
+            exit(1);
+        }
+    }
+
+    // Walk the jump chains (rand_val() is never 0 or 1)
+    num_hold = 0;
+    for (i = 0; i < num; i++)
+    {
+        ph->count[i] = 0;
+        state = ph_next(ph, ph->m);
+        while (state != ph->m)
+        {
+            // Grow the work buffers if needed
+            if (num_hold == ph->num_work)
+                ph_grow(ph);
+            ph->u[num_hold] = rand_val(0);
+            ph->w[num_hold] = ph->mean[state];
+            num_hold++;
+            ph->count[i]++;
+            state = ph_next(ph, state);
+        }
+    }
+
+    // Compute the holding times using the inversion method
+    for (k = 0; k < num_hold; k++)
+        ph->u[k] = -ph->w[k] * poly_log(ph->u[k]);
+
+    // Sum the holding times for each value
+    k = 0;
+    for (i = 0; i < num; i++)
+    {
+        buf[i] = 0.0;
+        for (j = 0; j < ph->count[i]; j++)
+            buf[i] = buf[i] + ph->u[k++];
+    }
+}
+
+//===========================================================================
+//=  Function to pick the next phase from one row of the alias tables       =
+//=    - Input:  Sampler and row (a phase, or m for alpha)                  =
+//=    - Output: Returns the next phase (m is absorption)                   =
+//=    - One uniform gives both the column (integer part of z * (m + 1))    =
+//=      and the alias test (fraction part)                                 =
+//===========================================================================
+int ph_next(ph_t *ph, int row)
+{
+    double   z;                     // Uniform random number scaled by m + 1
+    int      col;                   // Alias table column
+
+    z = rand_val(0) * (ph->m + 1);
+    col = (int) z;
+    row = row * (ph->m + 1);
+    if ((z - col) < ph->prob[row + col])
+        return(col);
+    return(ph->alias[row + col]);
+}
+
+//===========================================================================
+//=  Function to double the size of the batch work buffers of a sampler     =
+//===========================================================================
+void ph_grow(ph_t *ph)
+{
+    ph->num_work = 2 * ph->num_work;
+    ph->u = (double *) realloc(ph->u, ph->num_work * sizeof(double));
+    ph->w = (double *) realloc(ph->w, ph->num_work * sizeof(double));
+    if ((ph->u == NULL) || (ph->w == NULL))
+    {
+        printf("ERROR - could not realloc space for work buffers \n");
+        exit(1);
+    }
+}
+
+//===========================================================================
+//=  Function to build an alias table using Vose's method                   =
+//=    - Input:  Probabilities p[0] to p[n - 1] (summing to 1)              =
+//=    - Output: Fills prob[] and alias[] so that outcome j is column j if  =
+//=      a uniform fraction is less than prob[j] and alias[j] otherwise     =
+//===========================================================================
+void alias_init(double *p, int n, double *prob, int *alias)
+{
+    int      *small, *large;        // Stacks of under and over full columns
+    int      num_small, num_large;  // Stack sizes
+    double   sum;                   // Sum of p[] for normalizing
+    int      s, l;                  // Small and large column
+    int      j;                     // Loop counter
+
+    small = (int *) malloc(n * sizeof(int));
+    large = (int *) malloc(n * sizeof(int));
+    if ((small == NULL) || (large == NULL))
+    {
+        printf("ERROR - could not malloc space for alias tables \n");
+        exit(1);
+    }
+
+    // Scale the probabilities to an average of 1 per column
+    sum = 0.0;
+    for (j = 0; j < n; j++)
+        sum = sum + p[j];
+    num_small = num_large = 0;
+    for (j = 0; j < n; j++)
+    {
+        prob[j] = p[j] * n / sum;
+        alias[j] = j;
+        if (prob[j] < 1.0)
+            small[num_small++] = j;
+        else
+            large[num_large++] = j;
+    }
+
+    // Fill each small column from a large column
+    while ((num_small > 0) && (num_large > 0))
+    {
+        s = small[--num_small];
+        l = large[--num_large];
+        alias[s] = l;
+        prob[l] = (prob[l] + prob[s]) - 1.0;
+        if (prob[l] < 1.0)
+            small[num_small++] = l;
+        else
+            large[num_large++] = l;
+    }
+
+    // Left over columns are full (up to round-off)
+    while (num_large > 0)
+        prob[large[--num_large]] = 1.0;
+    while (num_small > 0)
+        prob[small[--num_small]] = 1.0;
+
+    free(small);
+    free(large);
+}
+
+//===========================================================================
+//=  Function to compute log(x) for x > 0 without calling libm              =
+//=    - Splits x into 2^e * m with sqrt(1/2) <= m < sqrt(2) and then uses  =
+//=      log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172      =
+//=    - Accurate to within a few ulps for normal (non-denormal) x          =
+//===========================================================================
+static double poly_log(double x)
+{
+    unsigned long long bits;      // Bits of x
+    unsigned long long k;         // Biased exponent of x / sqrt(1/2)
+    unsigned long long ebits;     // Bits of 2^52 plus k
+    double    e, m, s, s2;        // Exponent, mantissa, and atanh variables
+
+    // Split x into 2^e * m with integer operations only (no compares and
+    // no integer to double conversion so that loops vectorize)
+    memcpy(&bits, &x, sizeof(bits));
+    k = (bits - 0x3fe6a09e667f3bcdULL + 0x4000000000000000ULL) >> 52;
+    ebits = k | 0x4330000000000000ULL;
+    memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1024.0);
+    bits = bits - (k << 52) + 0x4000000000000000ULL;
+    memcpy(&m, &bits, sizeof(m));
+
+    // Series for atanh(s) up to the s^17 term
+    s = (m - 1.0) / (m + 1.0);
+    s2 = s * s;
+    return((e * LN2_D) + 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5
+        + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 * (1.0 / 11 + s2 * (1.0 / 13
+        + s2 * (1.0 / 15 + s2 * (1.0 / 17))))))))));
+}
+
+//=========================================================================
+//= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
+//=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
+//=   - With x seeded to 1 the 10000th x value should be 1043618065       =
+//=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
+//=     John Wiley & Sons, 1991. (Page 443, Figure 26.2)                  =
+//=========================================================================
+double rand_val(int seed)
+{
+    const long  a =      16807;  // Multiplier
+    const long  m = 2147483647;  // Modulus
+    const long  q =     127773;  // m div a
+    const long  r =       2836;  // m mod a
+    static long x;               // Random int value
+    long        x_div_q;         // x divided by q
+    long        x_mod_q;         // x modulo q
+    long        x_new;           // New x value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0.0);
+    }
+
+    // RNG using integer arithmetic
+    x_div_q = x / q;
+    x_mod_q = x % q;
+    x_new = (a * x_mod_q) - (r * x_div_q);
+    if (x_new > 0)
+        x = x_new;
+    else
+        x = x_new + m;
+
+    // Return a random value between 0.0 and 1.0
+    return((double) x / m);
+}
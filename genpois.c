@@ -3,6 +3,8 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Uses inversion for means below 10 and Hormann's PTRS method  =
+//=            (O(1) expected time) for larger means                        =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -22,11 +24,11 @@
 //=-------------------------------------------------------------------------=
 //= Example output file ("output.dat" for above):                           =
 //=                                                                         =
-//=   0                                                                     =
-//=   9                                                                     =
-//=   6                                                                     =
-//=   10                                                                    =
 //=   13                                                                    =
+//=   10                                                                    =
+//=   9                                                                     =
+//=   14                                                                    =
+//=   12                                                                    =
 //=-------------------------------------------------------------------------=
 //=  Build: bcc32 genpois.c                                                 =
 //=-------------------------------------------------------------------------=
@@ -43,11 +45,15 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
-#include <math.h>               // Needed for log()
+#include <math.h>               // Needed for exp(), log(), and floor()
+
+//----- Defines -------------------------------------------------------------
+#define PTRS_MIN_MEAN  10.0     // Smallest mean that uses the PTRS method
 
 //----- Function prototypes -------------------------------------------------
 int    poisson(double x);       // Returns a Poisson random variable
-double expon(double x);         // Returns an exponential random variable
+int    poisson_inv(double mu);  // Poisson rv using inversion
+int    poisson_ptrs(double mu); // Poisson rv using PTRS
 double rand_val(int seed);      // Jain's RNG
 
 //===== Main program ========================================================
@@ -112,48 +118,106 @@ void main(void)
 
 //===========================================================================
 //=  Function to generate Poisson distributed random variables              =
-//=    - Input:  Mean value of distribution                                 =
+//=    - Input:  Mean interarrival time (the Poisson mean is 1 / x)         =
 //=    - Output: Returns with Poisson distributed random variable           =
 //===========================================================================
 int poisson(double x)
 {
+    double mu;                    // Mean of the Poisson distribution
+
+    // Use inversion for small means and PTRS for large means
+    mu = 1.0 / x;
+    if (mu < PTRS_MIN_MEAN)
+        return(poisson_inv(mu));
+    else
+        return(poisson_ptrs(mu));
+}
+
+//===========================================================================
+//=  Function to generate Poisson random variables using inversion          =
+//=    - Input:  Mean of distribution (mu < PTRS_MIN_MEAN)                  =
+//=    - Output: Returns with Poisson distributed random variable           =
+//=    - Sequential search of the CDF using one uniform per value           =
+//===========================================================================
+int poisson_inv(double mu)
+{
+    static double last_mu = -1.0; // Mean used for exp_mu
+    static double exp_mu;         // Pre-computed exp(-mu)
+    double z;                     // Uniform random number (0 < z < 1)
+    double p;                     // Probability of poi_value
+    double sum_p;                 // Cumulative probability up to poi_value
     int    poi_value;             // Computed Poisson value to be returned
-    double t_sum;                 // Time sum value
 
-    // Loop to generate Poisson values using exponential distribution
+    // Recompute exp(-mu) only when the mean changes
+    if (mu != last_mu)
+    {
+        exp_mu = exp(-mu);
+        last_mu = mu;
+    }
+
+    // Search the CDF for the first value with sum_p >= z
+    z = rand_val(0);
     poi_value = 0;
-    t_sum = 0.0;
-    while(1)
+    p = exp_mu;
+    sum_p = p;
+    while (z > sum_p)
     {
-        t_sum = t_sum + expon(x);
-        if (t_sum >= 1.0) break;
         poi_value++;
+        p = p * mu / poi_value;
+        sum_p = sum_p + p;
     }
 
     return(poi_value);
 }
 
 //===========================================================================
-//=  Function to generate exponentially distributed random variables        =
-//=    - Input:  Mean value of distribution                                 =
-//=    - Output: Returns with exponentially distributed random variable     =
+//=  Function to generate Poisson random variables using the PTRS method    =
+//=  from W. Hormann, "The Transformed Rejection Method for Generating      =
+//=  Poisson Random Variables," Insurance: Mathematics and Economics,       =
+//=  Vol. 12, No. 1, 1993.                                                  =
+//=    - Input:  Mean of distribution (mu >= PTRS_MIN_MEAN)                 =
+//=    - Output: Returns with Poisson distributed random variable           =
+//=    - Uses about 2.3 uniforms per value and no log() for most values     =
 //===========================================================================
-double expon(double x)
+int poisson_ptrs(double mu)
 {
-    double z;                     // Uniform random number (0 < z < 1)
-    double exp_value;             // Computed exponential value to be returned
+    static double last_mu = -1.0; // Mean used for the constants below
+    static double a, b;           // Hat function constants
+    static double inv_alpha;      // Hat function scale
+    static double v_r;            // Bound of the fast accept region
+    static double log_mu;         // Pre-computed log(mu)
+    static double log_inv_alpha;  // Pre-computed log(inv_alpha)
+    double u, v;                  // Uniform random numbers
+    double us;                    // Distance of u from the edges
+    double k;                     // Candidate Poisson value
 
-    // Pull a uniform random number (0 < z < 1)
-    do
+    // Recompute the constants only when the mean changes
+    if (mu != last_mu)
     {
-        z = rand_val(0);
+        b = 0.931 + 2.53 * sqrt(mu);
+        a = -0.059 + 0.02483 * b;
+        inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+        v_r = 0.9277 - 3.6224 / (b - 2.0);
+        log_mu = log(mu);
+        log_inv_alpha = log(inv_alpha);
+        last_mu = mu;
     }
-    while ((z == 0) || (z == 1));
-
-    // Compute exponential random variable using inversion method
-    exp_value = -x * log(z);
 
-    return(exp_value);
+    // Transformed rejection with squeeze
+    while (1)
+    {
+        u = rand_val(0) - 0.5;
+        v = rand_val(0);
+        us = 0.5 - fabs(u);
+        k = floor((2.0 * a / us + b) * u + mu + 0.43);
+        if ((us >= 0.07) && (v <= v_r))
+            return((int) k);
+        if ((k < 0.0) || ((us < 0.013) && (v > us)))
+            continue;
+        if ((log(v) + log_inv_alpha - log(a / (us * us) + b))
+            <= (-mu + k * log_mu - lgamma(k + 1.0)))
+            return((int) k);
+    }
 }
 
 //=========================================================================
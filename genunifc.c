@@ -3,6 +3,24 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Precision 1 is the original 31-bit LCG value x / m (about    =
+//=            2^31 different values)                                       =
+//=         4) Precision 2 fills blocks of doubles from a 64-bit splitmix   =
+//=            RNG.  The top 52 bits of a word are OR-ed into the mantissa  =
+//=            of 1.0 to give d on [1, 2) and z = d - 1 + 2^-53 is then one =
+//=            of the 2^52 midpoints (2k + 1) / 2^53, so 0 < z < 1 always   =
+//=            and no rejection is needed.  The conversion is a plain loop  =
+//=            of OR, subtract, and scale that the compiler vectorizes.     =
+//=            This is 52 bits and not 53: a 53-bit (r >> 11) * 2^-53 can   =
+//=            be 0, and adding a half-ulp offset to it rounds the top      =
+//=            value up to 1.0 (steps above 0.5 are 2^-53 wide), so no      =
+//=            53-bit grid stays inside (0, 1).  The u64 to double convert  =
+//=            it needs also does not vectorize without AVX-512.            =
+//=         5) Precision 3 does the same for floats (0x3F800000 with 23     =
+//=            bits and z = f - 1 + 2^-24), two floats per 64-bit word      =
+//=         6) For precisions 2 and 3 z is strictly inside (0, 1), but the  =
+//=            scaling z * (max - min) + min is rounded, so a value can     =
+//=            come out as exactly min or exactly max                       =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -13,6 +31,7 @@
 //=  Random number seed =================================> 1                =
 //=  Min value (continuous) =============================> 1.0              =
 //=  Max value (continuous) =============================> 2.0              =
+//=  Precision (1 = 31-bit, 2 = double, 3 = float) ======> 1                =
 //=  Number of values to generate =======================> 5                =
 //=  --------------------------------------------------------               =
 //=  -  Generating samples to file                          -               =
@@ -46,10 +65,18 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
+#include <string.h>             // Needed for memcpy()
+#include <stdint.h>             // Needed for uint64_t and uint32_t
+
+//----- Defines -------------------------------------------------------------
+#define UNIFC_BLOCK    1024     // Number of values generated per batch
 
 //----- Function prototypes -------------------------------------------------
-double unifc(double min, double max);  // Returns a continuous uniform RV
-double rand_valc(int seed);            // Jain's RNG to return 0 < z < 1
+double   unifc(double min, double max);  // Returns a continuous uniform RV
+void     unifc_fill(double *buf, int num, double min, double max);
+void     unifc_fillf(float *buf, int num, float min, float max);
+double   rand_valc(int seed);            // Jain's RNG to return 0 < z < 1
+uint64_t rand_val64(uint64_t seed);      // 64-bit splitmix RNG
 
 //===== Main program ========================================================
 void main(void)
@@ -60,8 +87,12 @@ void main(void)
     double   min;                 // Minimum value
     double   max;                 // Maximum value
     double   unif_rv;             // Uniformly random variable
+    double   unif_buf[UNIFC_BLOCK];   // Batch of doubles
+    float    unif_fbuf[UNIFC_BLOCK];  // Batch of floats
+    int      precision;           // 1 = 31-bit, 2 = double, 3 = float
     int      num_values;          // Number of values
-    int      i;                   // Loop counter
+    int      num_block;           // Number of values in this batch
+    int      i, j;                // Loop counters
 
     // Output banner
     printf("--------------------------------------- genunifc.c ----- \n");
@@ -82,6 +113,7 @@ void main(void)
     printf("Random number seed =================================> ");
     scanf("%s", temp_string);
     rand_valc((int) atoi(temp_string));
+    rand_val64((uint64_t) atoll(temp_string));
 
     // Prompt for min value
     printf("Min value (continuous) =============================> ");
@@ -93,6 +125,11 @@ void main(void)
     scanf("%s", temp_string);
     max = atof(temp_string);
 
+    // Prompt for precision
+    printf("Precision (1 = 31-bit, 2 = double, 3 = float) ======> ");
+    scanf("%s", temp_string);
+    precision = atoi(temp_string);
+
     // Prompt for number of values to generate
     printf("Number of values to generate =======================> ");
     scanf("%s", temp_string);
@@ -104,10 +141,34 @@ void main(void)
     printf("-------------------------------------------------------- \n");
 
     // Generate and output interarrival times
-    for (i = 0; i < num_values; i++)
+    if ((precision == 2) || (precision == 3))
     {
-        unif_rv = unifc(min, max);
-        fprintf(fp, "%f \n", unif_rv);
+        for (i = 0; i < num_values; i = i + num_block)
+        {
+            num_block = num_values - i;
+            if (num_block > UNIFC_BLOCK)
+                num_block = UNIFC_BLOCK;
+            if (precision == 2)
+            {
+                unifc_fill(unif_buf, num_block, min, max);
+                for (j = 0; j < num_block; j++)
+                    fprintf(fp, "%.17g \n", unif_buf[j]);
+            }
+            else
+            {
+                unifc_fillf(unif_fbuf, num_block, (float) min, (float) max);
+                for (j = 0; j < num_block; j++)
+                    fprintf(fp, "%.9g \n", unif_fbuf[j]);
+            }
+        }
+    }
+    else
+    {
+        for (i = 0; i < num_values; i++)
+        {
+            unif_rv = unifc(min, max);
+            fprintf(fp, "%f \n", unif_rv);
+        }
     }
 
     //Output message and close the output file
@@ -136,6 +197,80 @@ double unifc(double min, double max)
     return(unif_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with uniform doubles                         =
+//=    - Input:  Buffer, number of values, and min and max values           =
+//=    - Output: Fills buf[0] to buf[num - 1] with values on (min, max)     =
+//=      (before rounding of the scaling) at 2^-52 resolution               =
+//=    - Random words are drawn first and then converted in a separate      =
+//=      loop so that the conversion vectorizes                             =
+//===========================================================================
+void unifc_fill(double *buf, int num, double min, double max)
+{
+    uint64_t r[UNIFC_BLOCK];      // Block of random words
+    uint64_t u;                   // Bits of 1.0 with a random mantissa
+    double   d;                   // Value on [1, 2)
+    double   range;               // max - min
+    int      i, k, n;             // Loop counters and block size
+
+    range = max - min;
+    for (k = 0; k < num; k = k + n)
+    {
+        n = num - k;
+        if (n > UNIFC_BLOCK)
+            n = UNIFC_BLOCK;
+        for (i = 0; i < n; i++)
+            r[i] = rand_val64(0);
+        for (i = 0; i < n; i++)
+        {
+            u = 0x3FF0000000000000ULL | (r[i] >> 12);
+            memcpy(&d, &u, sizeof(d));
+            buf[k + i] = (d - 1.0 + 0x1p-53) * range + min;
+        }
+    }
+}
+
+//===========================================================================
+//=  Function to fill a buffer with uniform floats                          =
+//=    - Input:  Buffer, number of values, and min and max values           =
+//=    - Output: Fills buf[0] to buf[num - 1] with values on (min, max)     =
+//=      (before rounding of the scaling) at 2^-23 resolution               =
+//=    - The high and low halves of each random word give two floats        =
+//===========================================================================
+void unifc_fillf(float *buf, int num, float min, float max)
+{
+    uint64_t r[UNIFC_BLOCK / 2];  // Block of random words
+    uint32_t u;                   // Bits of 1.0f with a random mantissa
+    float    f;                   // Value on [1, 2)
+    float    range;               // max - min
+    int      i, k, n;             // Loop counters and block size
+
+    range = max - min;
+    for (k = 0; k < num; k = k + n)
+    {
+        n = num - k;
+        if (n > UNIFC_BLOCK)
+            n = UNIFC_BLOCK;
+        for (i = 0; i < (n + 1) / 2; i++)
+            r[i] = rand_val64(0);
+        for (i = 0; i < n / 2; i++)
+        {
+            u = 0x3F800000 | (uint32_t) (r[i] >> 41);
+            memcpy(&f, &u, sizeof(f));
+            buf[k + 2 * i] = (f - 1.0f + 0x1p-24f) * range + min;
+            u = 0x3F800000 | ((uint32_t) r[i] >> 9);
+            memcpy(&f, &u, sizeof(f));
+            buf[k + 2 * i + 1] = (f - 1.0f + 0x1p-24f) * range + min;
+        }
+        if (n & 1)
+        {
+            u = 0x3F800000 | (uint32_t) (r[n / 2] >> 41);
+            memcpy(&f, &u, sizeof(f));
+            buf[k + n - 1] = (f - 1.0f + 0x1p-24f) * range + min;
+        }
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
@@ -171,3 +306,30 @@ double rand_valc(int seed)
     // Return a random value between 0.0 and 1.0
     return((double) x / m);
 }
+
+//=========================================================================
+//= 64-bit splitmix RNG for generating uniform 64-bit random words        =
+//=   - x_n = x_(n-1) + 0x9e3779b97f4a7c15 and output is a mix of x_n     =
+//=   - Seeding follows rand_valc() (a seed greater than 0 sets the state =
+//=     and returns zero)                                                 =
+//=   - From S. Vigna, "splitmix64.c," http://prng.di.unimi.it/           =
+//=========================================================================
+uint64_t rand_val64(uint64_t seed)
+{
+    static uint64_t x;           // State of the RNG
+    uint64_t        z;           // Mixed output value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0);
+    }
+
+    // Advance the state and mix it
+    x = x + 0x9e3779b97f4a7c15ULL;
+    z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return(z ^ (z >> 31));
+}
@@ -3,6 +3,16 @@
 //===========================================================================
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values                    =
+//=         3) Method 1 is the original z % (max - min + 1) + min on a      =
+//=            31-bit LCG value (slow divide, biased for large ranges, and  =
+//=            limited to ranges up to 2^31)                                =
+//=         4) Method 2 is Lemire's multiply-shift method on a 64-bit       =
+//=            splitmix RNG.  The top half of z * s is uniform on [0, s)    =
+//=            once the rare z whose low half is below 2^64 mod s are       =
+//=            rejected, so it is exact and only divides (to find 2^64 mod  =
+//=            s) on the rare possible-rejection path.  Ranges up to 2^32   =
+//=            take two values from each 64-bit word and wider ranges (up   =
+//=            to the full 64 bits) use a 64 x 64 bit multiply.             =
 //=-------------------------------------------------------------------------=
 //= Example user input:                                                     =
 //=                                                                         =
@@ -13,6 +23,7 @@
 //=  Random number seed =================================> 1                =
 //=  Min value (discrete) ===============================> 1                =
 //=  Max value (discrete) ===============================> 2                =
+//=  Method (1 = modulo, 2 = multiply-shift) ============> 1                =
 //=  Number of values to generate =======================> 5                =
 //=  --------------------------------------------------------               =
 //=  -  Generating samples to file                          -               =
@@ -46,10 +57,18 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>              // Needed for printf()
 #include <stdlib.h>             // Needed for exit() and ato*()
+#include <stdint.h>             // Needed for uint64_t and int64_t
+
+//----- Defines -------------------------------------------------------------
+#define UNIFD_BLOCK    1024     // Number of values generated per batch
 
 //----- Function prototypes -------------------------------------------------
-double unifd(int min, int max); // Returns a discrete uniform RV
-long   rand_vald(int seed);     // Jain's RNG to return a discrete number
+double   unifd(int min, int max); // Returns a discrete uniform RV
+void     unifd_fill(int64_t *buf, int num, int64_t min, int64_t max);
+uint64_t bounded64(uint64_t s);   // Uniform integer on [0, s)
+void     mul64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo);
+long     rand_vald(int seed);     // Jain's RNG to return a discrete number
+uint64_t rand_val64(uint64_t seed);   // 64-bit splitmix RNG
 
 //===== Main program ========================================================
 void main(void)
@@ -57,11 +76,14 @@ void main(void)
     FILE     *fp;                 // File pointer to output file
     char     file_name[256];      // Output file name string
     char     temp_string[256];    // Temporary string variable
-    int      min;                 // Minimum value
-    int      max;                 // Maximum value
+    int64_t  min;                 // Minimum value
+    int64_t  max;                 // Maximum value
     int      unif_rv;             // Uniformly random variable
+    int64_t  unif_buf[UNIFD_BLOCK];   // Batch of uniform random variables
+    int      method;              // 1 = modulo, 2 = multiply-shift
     int      num_values;          // Number of values
-    int      i;                   // Loop counter
+    int      num_block;           // Number of values in this batch
+    int      i, j;                // Loop counters
 
     // Output banner
     printf("--------------------------------------- genunifd.c ----- \n");
@@ -82,16 +104,33 @@ void main(void)
     printf("Random number seed =================================> ");
     scanf("%s", temp_string);
     rand_vald((int) atoi(temp_string));
+    rand_val64((uint64_t) atoll(temp_string));
 
     // Prompt for min value
     printf("Min value (discrete) ===============================> ");
     scanf("%s", temp_string);
-    min = atoi(temp_string);
+    min = atoll(temp_string);
 
     // Prompt for max value
     printf("Max value (discrete) ===============================> ");
     scanf("%s", temp_string);
-    max = atoi(temp_string);
+    max = atoll(temp_string);
+    if (max < min)
+    {
+        printf("ERROR - max value must not be less than min value \n");
+        exit(1);
+    }
+
+    // Prompt for method
+    printf("Method (1 = modulo, 2 = multiply-shift) ============> ");
+    scanf("%s", temp_string);
+    method = atoi(temp_string);
+    if ((method != 2) && ((min < -2147483647LL - 1) || (max > 2147483647LL) ||
+        (max - min >= 2147483647LL)))
+    {
+        printf("ERROR - method 1 needs int values with a range below 2^31 \n");
+        exit(1);
+    }
 
     // Prompt for number of values to generate
     printf("Number of values to generate =======================> ");
@@ -104,10 +143,25 @@ void main(void)
     printf("-------------------------------------------------------- \n");
 
     // Generate and output interarrival times
-    for (i = 0; i < num_values; i++)
+    if (method == 2)
     {
-        unif_rv = unifd(min, max);
-        fprintf(fp, "%d \n", unif_rv);
+        for (i = 0; i < num_values; i = i + num_block)
+        {
+            num_block = num_values - i;
+            if (num_block > UNIFD_BLOCK)
+                num_block = UNIFD_BLOCK;
+            unifd_fill(unif_buf, num_block, min, max);
+            for (j = 0; j < num_block; j++)
+                fprintf(fp, "%lld \n", (long long) unif_buf[j]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < num_values; i++)
+        {
+            unif_rv = unifd((int) min, (int) max);
+            fprintf(fp, "%d \n", unif_rv);
+        }
     }
 
     //Output message and close the output file
@@ -136,6 +190,113 @@ double unifd(int min, int max)
     return(unif_value);
 }
 
+//===========================================================================
+//=  Function to fill a buffer with discrete uniform random variables       =
+//=    - Input:  Buffer, number of values, and min and max values (any      =
+//=      min <= max, including the full 64-bit range)                       =
+//=    - Output: Fills buf[0] to buf[num - 1] with values on [min, max]     =
+//=    - The rejection threshold 2^k mod s is only computed (one divide)    =
+//=      the first time a low half falls below s                            =
+//===========================================================================
+void unifd_fill(int64_t *buf, int num, int64_t min, int64_t max)
+{
+    uint64_t s;                   // Range size (0 for all 2^64 values)
+    uint64_t z;                   // 64-bit random word
+    uint64_t m;                   // Product z * s (32-bit path)
+    uint32_t t32;                 // 2^32 mod s (32-bit path)
+    int      have_t;              // Rejection threshold is computed
+    int      h;                   // Half of z being used
+    int      i;                   // Loop counter
+
+    s = (uint64_t) max - (uint64_t) min + 1;
+
+    // Wide (or full) ranges use one 64-bit word per value
+    if ((s == 0) || (s > (((uint64_t) 1) << 32)))
+    {
+        for (i = 0; i < num; i++)
+            buf[i] = (int64_t) ((uint64_t) min + bounded64(s));
+        return;
+    }
+
+    // Ranges up to 2^32 use each 32-bit half of a 64-bit word
+    have_t = 0;
+    t32 = 0;
+    z = 0;
+    h = 1;
+    for (i = 0; i < num; )
+    {
+        if (h == 1)
+            z = rand_val64(0);
+        h = !h;
+        m = ((z >> (32 * h)) & 0xffffffffULL) * s;
+        if ((uint32_t) m < s)
+        {
+            if (!have_t)
+            {
+                t32 = (uint32_t) ((((uint64_t) 1) << 32) % s);
+                have_t = 1;
+            }
+            if ((uint32_t) m < t32)
+                continue;
+        }
+        buf[i++] = (int64_t) ((uint64_t) min + (m >> 32));
+    }
+}
+
+//===========================================================================
+//=  Function to generate a uniform integer on [0, s) by multiply-shift     =
+//=    - Input:  s (0 means all 2^64 values)                                =
+//=    - Output: Returns the top half of z * s, rejecting the rare z whose  =
+//=      low half is below 2^64 mod s so that the result is exact           =
+//===========================================================================
+uint64_t bounded64(uint64_t s)
+{
+    uint64_t hi, lo;              // Halves of the 128-bit product
+    uint64_t t;                   // 2^64 mod s
+
+    if (s == 0)
+        return(rand_val64(0));
+
+    mul64(rand_val64(0), s, &hi, &lo);
+    if (lo < s)
+    {
+        t = (0 - s) % s;
+        while (lo < t)
+            mul64(rand_val64(0), s, &hi, &lo);
+    }
+
+    return(hi);
+}
+
+//===========================================================================
+//=  Function to multiply two 64-bit words into a 128-bit product           =
+//=    - Input:  a and b                                                    =
+//=    - Output: Sets the high and low 64-bit halves of a * b               =
+//=    - Uses the compiler's 128-bit integers when it has them and 32-bit   =
+//=      partial products otherwise                                         =
+//===========================================================================
+void mul64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128) a * b;   // Full product
+
+    *hi = (uint64_t) (p >> 64);
+    *lo = (uint64_t) p;
+#else
+    uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;  // Halves of a
+    uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;  // Halves of b
+    uint64_t ll, lh, hl, hh, mid;                       // Partial products
+
+    ll = a_lo * b_lo;
+    lh = a_lo * b_hi;
+    hl = a_hi * b_lo;
+    hh = a_hi * b_hi;
+    mid = (ll >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    *lo = (mid << 32) | (ll & 0xffffffffULL);
+#endif
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
@@ -171,3 +332,30 @@ long rand_vald(int seed)
     // Return a random integer number
     return(x);
 }
+
+//=========================================================================
+//= 64-bit splitmix RNG for generating uniform 64-bit random words        =
+//=   - x_n = x_(n-1) + 0x9e3779b97f4a7c15 and output is a mix of x_n     =
+//=   - Seeding follows rand_vald() (a seed greater than 0 sets the state =
+//=     and returns zero)                                                 =
+//=   - From S. Vigna, "splitmix64.c," http://prng.di.unimi.it/           =
+//=========================================================================
+uint64_t rand_val64(uint64_t seed)
+{
+    static uint64_t x;           // State of the RNG
+    uint64_t        z;           // Mixed output value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0);
+    }
+
+    // Advance the state and mix it
+    x = x + 0x9e3779b97f4a7c15ULL;
+    z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return(z ^ (z >> 31));
+}
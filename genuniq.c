@@ -4,6 +4,33 @@
 //=  Notes: 1) Writes to a user specified output file                       =
 //=         2) Generates user specified number of values (up to 2^32 - 1)   =
 //=         3) Uses Roy Hann's Generate31()                                 =
+//=         4) Method 2 streams a random permutation of 0 to M - 1 with     =
+//=            O(1) memory.  Index i maps to a keyed Feistel network on the =
+//=            smallest even number of bits covering M (PERM_ROUNDS rounds, =
+//=            keys from a 64-bit splitmix RNG), and outputs of M or more   =
+//=            are fed back in (cycle-walking) until one is below M.  This  =
+//=            is a bijection on 0 to M - 1, so any range of indexes (e.g., =
+//=            one shard's slice) can be generated on its own.              =
+//=         5) Method 3 is an unbiased shuffle (method 1 swaps with a       =
+//=            random position over the whole array, which is biased) of    =
+//=            64-bit values that runs in parallel with OpenMP (gcc         =
+//=            -fopenmp).  Each value is scattered to a uniformly random    =
+//=            bucket of about SHUF_BUCKET values and each bucket is then   =
+//=            Fisher-Yates shuffled in cache.  Random streams belong to    =
+//=            fixed parts of the array and to buckets (not to threads),    =
+//=            so the output does not depend on the number of threads.      =
+//=         6) Method 4 samples k different values from 0 to M - 1 for      =
+//=            k much less than M (e.g., 1e8 values from 2^48) with Floyd's =
+//=            algorithm.  Values are kept in a linear probing hash set of  =
+//=            at least 2k slots (UINT64_MAX marks an empty slot), which is =
+//=            then packed and sorted or Fisher-Yates shuffled.             =
+//=         7) Generator31() is a linear map on 31 bits over GF(2), so      =
+//=            g31_jump() moves it any number of steps with precomputed     =
+//=            jump matrices for each power of two, and g31_fill() gives    =
+//=            G31_LANE states at once from one state (bits shifted out are =
+//=            replaced by bit i XOR bit i + 3 of the same state).  Method  =
+//=            3 fills its array in segments that each start with a jump,   =
+//=            in parallel, in exactly the serial Generator31() order.      =
 //=-------------------------------------------------------------------------=
 //= Example execution:                                                      =
 //=                                                                         =
@@ -12,6 +39,7 @@
 //=   --------------------------------------------------------              =
 //=   Output file name ===================================> out.dat         =
 //=   Random number seed (greater than 0) ================> 1               =
+//=   Method (1 shuffle, 2 keyed, 3 parallel, 4 sample) ==> 1               =
 //=   Number of unique values to generate ================> 1000000         =
 //=   --------------------------------------------------------              =
 //=   -  Generating samples to file                          -              =
@@ -20,7 +48,7 @@
 //=   -  Done!                                                              =
 //=   --------------------------------------------------------              =
 //=-------------------------------------------------------------------------=
-//=  Build: bcc32 genuniq.c                                                 =
+//=  Build: gcc -O3 -fopenmp genuniq.c, bcc32 genuniq.c                     =
 //=-------------------------------------------------------------------------=
 //=  Execute: genuniq                                                       =
 //=-------------------------------------------------------------------------=
@@ -35,10 +63,45 @@
 //----- Include files -------------------------------------------------------
 #include <stdio.h>             // Needed for printf()
 #include <stdlib.h>            // Needed for malloc(), atoi(), and exit()
+#include <stdint.h>            // Needed for uint64_t
+#include <string.h>            // Needed for memcpy()
+
+//----- Defines -------------------------------------------------------------
+#define PERM_ROUNDS    6       // Number of Feistel rounds
+#define SHUF_BUCKET    262144  // Target values per shuffle bucket (2 MB)
+#define SHUF_PARTS     256     // Number of parts the array is split into
+#define SET_EMPTY      UINT64_MAX  // Empty hash set slot
+#define G31_BITS       31      // Bits of Generator31() state
+#define G31_PERIOD     2147483647  // Period of Generator31() (2^31 - 1)
+#define G31_LANE       28      // States made at once by g31_fill()
+#define G31_SEG        65536   // States per parallel segment of g31_fill()
+
+//----- Type definitions ----------------------------------------------------
+typedef struct                 // Keyed permutation of 0 to m - 1
+{
+    uint64_t m;                // Range size
+    int      half;             // Bits in each Feistel half
+    uint64_t mask;             // Mask of half bits
+    uint64_t key[PERM_ROUNDS]; // Round keys
+} perm_t;
 
 //----- Function prototypes -------------------------------------------------
 int randInt(int seed);         // LCG RNG with x_n = 7^5*x_(n-1)mod(2^31 - 1)
 int Generator31(void);         // Unique value RNG credited to Roy Hann
+uint32_t g31_jump(uint32_t n, uint64_t steps);    // Jump Generator31()
+void     g31_fill(uint64_t *buf, uint64_t num, uint32_t n);   // Batch
+void     perm_init(perm_t *pm, uint64_t m);       // Set up a permutation
+uint64_t perm_index(perm_t *pm, uint64_t i);      // Value at index i
+uint64_t feistel(perm_t *pm, uint64_t x);         // One Feistel pass
+void     shuffle64(uint64_t *a, uint64_t n, uint64_t key);  // Bucket shuffle
+void     fisher_yates(uint64_t *a, uint64_t n, uint64_t *x);
+uint64_t *sample_floyd(uint64_t m, uint64_t k, uint64_t *x, int sorted);
+int      set_insert(uint64_t *set, int bits, uint64_t v);  // Add to hash set
+int      cmp_u64(const void *a, const void *b);   // qsort() comparator
+uint64_t rand_bounded(uint64_t *x, uint64_t s);   // Uniform on [0, s)
+void     mul64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo);
+uint64_t split_next(uint64_t *x);                 // Splitmix stream step
+uint64_t rand_val64(uint64_t seed);               // 64-bit splitmix RNG
 
 //===========================================================================
 //=  Main program                                                           =
@@ -52,6 +115,16 @@ void main()
     int    *z;                   // Array of shuffled unique integers
     int     temp;                // Temporary value
     int     i, j;                // Indexes
+    int     method;              // 1 = shuffle, 2 = keyed, 3 = parallel,
+                                 // 4 = sample
+    int     order;               // 1 = sorted, 2 = random
+    uint64_t x;                  // Random stream state
+    uint64_t *z64;               // Array of 64-bit values to shuffle
+    perm_t  pm;                  // Keyed permutation
+    uint64_t m;                  // Range size for a keyed permutation
+    uint64_t first;              // First index to output
+    uint64_t count;              // Number of indexes to output
+    uint64_t k;                  // Index
 
     // Output banner
     printf("---------------------------------------- genuniq.c ----- \n");
@@ -72,6 +145,112 @@ void main()
     printf("Random number seed (greater than 0) ================> ");
     scanf("%s", temp_string);
     randInt((int) atoi(temp_string));
+    rand_val64((uint64_t) atoll(temp_string));
+
+    // Prompt for method
+    printf("Method (1 shuffle, 2 keyed, 3 parallel, 4 sample) ==> ");
+    scanf("%s", temp_string);
+    method = atoi(temp_string);
+
+    // Keyed permutation streams values without an array
+    if (method == 2)
+    {
+        printf("Range size M (values are 0 to M - 1) ===============> ");
+        scanf("%s", temp_string);
+        m = strtoull(temp_string, NULL, 10);
+        printf("First index to output (0 to M - 1) =================> ");
+        scanf("%s", temp_string);
+        first = strtoull(temp_string, NULL, 10);
+        printf("Number of unique values to generate ================> ");
+        scanf("%s", temp_string);
+        count = strtoull(temp_string, NULL, 10);
+        if ((m == 0) || (first > m) || (count > m - first))
+        {
+            printf("*** ERROR - indexes must be in 0 to M - 1 \n");
+            exit(1);
+        }
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Generating samples to file                          - \n");
+        printf("-------------------------------------------------------- \n");
+        perm_init(&pm, m);
+        for (k = first; k < first + count; k++)
+            fprintf(fp, "%llu \n", (unsigned long long) perm_index(&pm, k));
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Done!                                               - \n");
+        printf("-------------------------------------------------------- \n");
+        fclose(fp);
+        return;
+    }
+
+    // Parallel unbiased shuffle of a 64-bit array
+    if (method == 3)
+    {
+        printf("Number of unique values to generate ================> ");
+        scanf("%s", temp_string);
+        count = strtoull(temp_string, NULL, 10);
+        if (count > 2147483647)
+        {
+            printf("*** ERROR - Generator31() has only 2^31 - 1 values \n");
+            exit(1);
+        }
+        z64 = (uint64_t *) malloc(count * sizeof(uint64_t));
+        if (z64 == NULL)
+        {
+            printf("*** ERROR - could not malloc space for array \n");
+            exit(1);
+        }
+        g31_fill(z64, count, 1);
+        shuffle64(z64, count, rand_val64(0));
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Generating samples to file                          - \n");
+        printf("-------------------------------------------------------- \n");
+        for (k = 0; k < count; k++)
+            fprintf(fp, "%llu \n", (unsigned long long) z64[k]);
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Done!                                               - \n");
+        printf("-------------------------------------------------------- \n");
+        fclose(fp);
+        free(z64);
+        return;
+    }
+
+    // Sparse sampling of k values from 0 to M - 1
+    if (method == 4)
+    {
+        printf("Range size M (values are 0 to M - 1) ===============> ");
+        scanf("%s", temp_string);
+        m = strtoull(temp_string, NULL, 10);
+        printf("Number of unique values to generate ================> ");
+        scanf("%s", temp_string);
+        count = strtoull(temp_string, NULL, 10);
+        printf("Output order (1 = sorted, 2 = random) ==============> ");
+        scanf("%s", temp_string);
+        order = atoi(temp_string);
+        if (count > m)
+        {
+            printf("*** ERROR - cannot sample more than M values \n");
+            exit(1);
+        }
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Generating samples to file                          - \n");
+        printf("-------------------------------------------------------- \n");
+        x = rand_val64(0);
+        z64 = sample_floyd(m, count, &x, (order != 2));
+        for (k = 0; k < count; k++)
+            fprintf(fp, "%llu \n", (unsigned long long) z64[k]);
+
+        printf("-------------------------------------------------------- \n");
+        printf("-  Done!                                               - \n");
+        printf("-------------------------------------------------------- \n");
+        fclose(fp);
+        free(z64);
+        return;
+    }
 
     // Prompt for number of values to generate
     printf("Number of unique values to generate ================> ");
@@ -130,6 +309,446 @@ int Generator31(void)
     return n;
 }
 
+//===========================================================================
+//=  Function to set up a keyed permutation of 0 to m - 1                   =
+//=    - Input:  Permutation and range size m (greater than 0)              =
+//=    - Output: Sets the Feistel half size so that 2^(2 * half) >= m       =
+//=      (at most 4 times m, so cycle-walking takes under 4 passes on       =
+//=      average) and draws the round keys from rand_val64()                =
+//===========================================================================
+void perm_init(perm_t *pm, uint64_t m)
+{
+    int     i;                   // Loop counter
+
+    pm->m = m;
+    pm->half = 1;
+    while ((pm->half < 32) && (((m - 1) >> (2 * pm->half)) != 0))
+        pm->half++;
+    pm->mask = (((uint64_t) 1) << pm->half) - 1;
+    for (i = 0; i < PERM_ROUNDS; i++)
+        pm->key[i] = rand_val64(0);
+}
+
+//===========================================================================
+//=  Function to return the value at index i of a keyed permutation         =
+//=    - Input:  Permutation and index i (0 to m - 1)                       =
+//=    - Output: Returns the value (0 to m - 1) by cycle-walking            =
+//===========================================================================
+uint64_t perm_index(perm_t *pm, uint64_t i)
+{
+    uint64_t x;                  // Value being walked
+
+    x = feistel(pm, i);
+    while (x >= pm->m)
+        x = feistel(pm, x);
+
+    return(x);
+}
+
+//===========================================================================
+//=  Function to run one pass of a balanced Feistel network                 =
+//=    - Input:  Permutation and a value of 2 * half bits                   =
+//=    - Output: Returns the permuted value of 2 * half bits                =
+//=    - The round function is the splitmix64 mix of the right half plus    =
+//=      the round key                                                      =
+//===========================================================================
+uint64_t feistel(perm_t *pm, uint64_t x)
+{
+    uint64_t l, r, f;            // Left half, right half, and round value
+    int      i;                  // Loop counter
+
+    l = (x >> pm->half) & pm->mask;
+    r = x & pm->mask;
+    for (i = 0; i < PERM_ROUNDS; i++)
+    {
+        f = r + pm->key[i];
+        f = (f ^ (f >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        f = (f ^ (f >> 27)) * 0x94d049bb133111ebULL;
+        f = (f ^ (f >> 31)) & pm->mask;
+        f = l ^ f;
+        l = r;
+        r = f;
+    }
+
+    return((l << pm->half) | r);
+}
+
+//===========================================================================
+//=  Function to shuffle a 64-bit array in parallel (unbiased)              =
+//=    - Input:  Array, number of values, and a random key                  =
+//=    - Output: Puts the array in a uniformly random order                 =
+//=    - Pass 1 counts the bucket of every value in each part, the counts   =
+//=      give each (bucket, part) pair its place, pass 2 redraws the same   =
+//=      buckets and scatters the values, and pass 3 shuffles each bucket   =
+//=      and copies it back.  Needs a second array of n values.             =
+//===========================================================================
+void shuffle64(uint64_t *a, uint64_t n, uint64_t key)
+{
+    uint64_t *tmp;               // Scattered values
+    uint64_t *pos;               // Count (then next place) per part, bucket
+    uint64_t *start;             // Start of each bucket in tmp[]
+    uint64_t num_bucket;         // Number of buckets
+    uint64_t part_size;          // Values per part
+    uint64_t x;                  // Random stream state
+    uint64_t off;                // Running offset
+    uint64_t c;                  // Count
+    uint64_t i, lo, hi;          // Index and part bounds
+    long     p, b;               // Part and bucket counters
+
+    // Small arrays are shuffled in place
+    num_bucket = (n + SHUF_BUCKET - 1) / SHUF_BUCKET;
+    if (num_bucket <= 1)
+    {
+        x = key;
+        fisher_yates(a, n, &x);
+        return;
+    }
+
+    part_size = (n + SHUF_PARTS - 1) / SHUF_PARTS;
+    tmp = (uint64_t *) malloc(n * sizeof(uint64_t));
+    pos = (uint64_t *) calloc(SHUF_PARTS * num_bucket, sizeof(uint64_t));
+    start = (uint64_t *) malloc((num_bucket + 1) * sizeof(uint64_t));
+    if ((tmp == NULL) || (pos == NULL) || (start == NULL))
+    {
+        printf("*** ERROR - could not malloc space for shuffle \n");
+        exit(1);
+    }
+
+    // Pass 1 -- count the values going to each bucket from each part
+    #pragma omp parallel for private(x, i, lo, hi) schedule(dynamic)
+    for (p = 0; p < SHUF_PARTS; p++)
+    {
+        x = key + p;
+        x = split_next(&x);
+        lo = p * part_size;
+        hi = (lo + part_size < n) ? (lo + part_size) : n;
+        for (i = lo; i < hi; i++)
+            pos[p * num_bucket + rand_bounded(&x, num_bucket)]++;
+    }
+
+    // Place the parts in order within each bucket
+    off = 0;
+    for (b = 0; b < (long) num_bucket; b++)
+    {
+        start[b] = off;
+        for (p = 0; p < SHUF_PARTS; p++)
+        {
+            c = pos[p * num_bucket + b];
+            pos[p * num_bucket + b] = off;
+            off = off + c;
+        }
+    }
+    start[num_bucket] = n;
+
+    // Pass 2 -- scatter the values to the same buckets
+    #pragma omp parallel for private(x, i, lo, hi) schedule(dynamic)
+    for (p = 0; p < SHUF_PARTS; p++)
+    {
+        x = key + p;
+        x = split_next(&x);
+        lo = p * part_size;
+        hi = (lo + part_size < n) ? (lo + part_size) : n;
+        for (i = lo; i < hi; i++)
+            tmp[pos[p * num_bucket + rand_bounded(&x, num_bucket)]++] = a[i];
+    }
+
+    // Pass 3 -- shuffle each bucket and copy it back
+    #pragma omp parallel for private(x) schedule(dynamic)
+    for (b = 0; b < (long) num_bucket; b++)
+    {
+        x = key + SHUF_PARTS + b;
+        x = split_next(&x);
+        fisher_yates(&tmp[start[b]], start[b + 1] - start[b], &x);
+        memcpy(&a[start[b]], &tmp[start[b]],
+            (start[b + 1] - start[b]) * sizeof(uint64_t));
+    }
+
+    free(tmp);
+    free(pos);
+    free(start);
+}
+
+//===========================================================================
+//=  Function to Fisher-Yates shuffle an array                              =
+//=    - Input:  Array, number of values, and random stream state           =
+//=    - Output: Puts the array in a uniformly random order                 =
+//===========================================================================
+void fisher_yates(uint64_t *a, uint64_t n, uint64_t *x)
+{
+    uint64_t temp;               // Temporary value
+    uint64_t i, j;               // Indexes
+
+    for (i = n; i > 1; i--)
+    {
+        j = rand_bounded(x, i);
+        temp = a[i - 1];
+        a[i - 1] = a[j];
+        a[j] = temp;
+    }
+}
+
+//===========================================================================
+//=  Function to sample k different values from 0 to m - 1 (Floyd)          =
+//=    - Input:  m, k (at most m), random stream state, and sorted flag     =
+//=    - Output: Returns a malloc()ed array of the k values, sorted or in   =
+//=      random order (exits on error)                                      =
+//=    - For j = m - k to m - 1, t is drawn from 0 to j and j is added if   =
+//=      t is already in the set (t otherwise), so each step adds exactly   =
+//=      one value and every k-subset is equally likely                     =
+//===========================================================================
+uint64_t *sample_floyd(uint64_t m, uint64_t k, uint64_t *x, int sorted)
+{
+    uint64_t *set;               // Hash set (packed into the result)
+    uint64_t num_slot;           // Number of hash slots
+    uint64_t j, t;               // Floyd step and draw
+    uint64_t i, n;               // Slot and packed counters
+    int      bits;               // log2(num_slot)
+
+    for (bits = 1; (((uint64_t) 1) << bits) < 2 * k; bits++)
+        ;
+    num_slot = ((uint64_t) 1) << bits;
+    set = (uint64_t *) malloc(num_slot * sizeof(uint64_t));
+    if (set == NULL)
+    {
+        printf("*** ERROR - could not malloc space for hash set \n");
+        exit(1);
+    }
+    for (i = 0; i < num_slot; i++)
+        set[i] = SET_EMPTY;
+
+    for (j = m - k; j < m; j++)
+    {
+        t = rand_bounded(x, j + 1);
+        if (!set_insert(set, bits, t))
+            set_insert(set, bits, j);
+    }
+
+    // Pack the values to the front and put them in order
+    n = 0;
+    for (i = 0; i < num_slot; i++)
+        if (set[i] != SET_EMPTY)
+            set[n++] = set[i];
+    if (sorted)
+        qsort(set, n, sizeof(uint64_t), cmp_u64);
+    else
+        fisher_yates(set, n, x);
+
+    return(set);
+}
+
+//===========================================================================
+//=  Function to add a value to a linear probing hash set                   =
+//=    - Input:  Set of 2^bits slots, bits, and value (not SET_EMPTY)       =
+//=    - Output: Returns 1 if the value was added or 0 if it was there      =
+//===========================================================================
+int set_insert(uint64_t *set, int bits, uint64_t v)
+{
+    uint64_t s;                  // Hash slot
+    uint64_t mask;               // Number of slots - 1
+
+    mask = (((uint64_t) 1) << bits) - 1;
+    s = (v * 0x9e3779b97f4a7c15ULL) >> (64 - bits);
+    while (set[s] != SET_EMPTY)
+    {
+        if (set[s] == v)
+            return(0);
+        s = (s + 1) & mask;
+    }
+    set[s] = v;
+
+    return(1);
+}
+
+//===========================================================================
+//=  Function to compare values for an ascending qsort()                    =
+//===========================================================================
+int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return((x > y) ? 1 : ((x < y) ? -1 : 0));
+}
+
+//===========================================================================
+//=  Function to return a uniform integer on [0, s) (Lemire)                =
+//=    - Input:  Random stream state and s (1 to 2^64 - 1)                  =
+//=    - Output: Returns the top half of a random value times s, rejecting  =
+//=      the rare values whose low half is below 2^32 (or 2^64) mod s       =
+//=    - s up to 2^32 uses 32 random bits and a 64-bit product            =
+//===========================================================================
+uint64_t rand_bounded(uint64_t *x, uint64_t s)
+{
+    uint64_t m;                  // Product of 32 random bits and s
+    uint64_t hi, lo;             // Halves of a 128-bit product
+    uint64_t t64;                // 2^64 mod s
+    uint32_t t;                  // 2^32 mod s
+
+    // Wide ranges use a 64 x 64 bit product
+    if (s > (((uint64_t) 1) << 32))
+    {
+        mul64(split_next(x), s, &hi, &lo);
+        if (lo < s)
+        {
+            t64 = (0 - s) % s;
+            while (lo < t64)
+                mul64(split_next(x), s, &hi, &lo);
+        }
+        return(hi);
+    }
+
+    m = (split_next(x) >> 32) * s;
+    if ((uint32_t) m < s)
+    {
+        t = (uint32_t) ((((uint64_t) 1) << 32) % s);
+        while ((uint32_t) m < t)
+            m = (split_next(x) >> 32) * s;
+    }
+
+    return(m >> 32);
+}
+
+//===========================================================================
+//=  Function to multiply two 64-bit words into a 128-bit product           =
+//=    - Input:  a and b                                                    =
+//=    - Output: Sets the high and low 64-bit halves of a * b               =
+//=    - Uses the compiler's 128-bit integers when it has them and 32-bit   =
+//=      partial products otherwise                                         =
+//===========================================================================
+void mul64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128) a * b;   // Full product
+
+    *hi = (uint64_t) (p >> 64);
+    *lo = (uint64_t) p;
+#else
+    uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;  // Halves of a
+    uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;  // Halves of b
+    uint64_t ll, lh, hl, hh, mid;                       // Partial products
+
+    ll = a_lo * b_lo;
+    lh = a_lo * b_hi;
+    hl = a_hi * b_lo;
+    hh = a_hi * b_hi;
+    mid = (ll >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    *lo = (mid << 32) | (ll & 0xffffffffULL);
+#endif
+}
+
+//===========================================================================
+//=  Function to step a splitmix stream held by the caller                  =
+//=    - Input:  Pointer to the stream state                                =
+//=    - Output: Advances the state and returns a 64-bit random word        =
+//===========================================================================
+uint64_t split_next(uint64_t *x)
+{
+    uint64_t z;                  // Mixed output value
+
+    *x = *x + 0x9e3779b97f4a7c15ULL;
+    z = *x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return(z ^ (z >> 31));
+}
+
+//===========================================================================
+//=  Function to move a Generator31() state ahead any number of steps       =
+//=    - Input:  State n (non-zero) and number of steps                     =
+//=    - Output: Returns the state after steps steps (mod the period)       =
+//=    - Column i of jump[k] is the state after 2^k steps from the state    =
+//=      with only bit i set, so a jump XORs together the columns of the    =
+//=      set bits of the state for each one bit of steps                    =
+//===========================================================================
+uint32_t g31_jump(uint32_t n, uint64_t steps)
+{
+    static int      first = 1;               // Static first time flag
+    static uint32_t jump[G31_BITS][G31_BITS]; // Jump matrices (by column)
+    uint32_t        x, v;                    // State and matrix product
+    int             i, j, k;                 // Loop counters
+
+    // Build the jump matrices the first time only (squaring each one)
+    if (first)
+    {
+        for (i = 0; i < G31_BITS; i++)
+        {
+            x = ((uint32_t) 1) << i;
+            jump[0][i] = (x >> 1) | (((x ^ (x >> 3)) & 1) << 30);
+        }
+        for (k = 1; k < G31_BITS; k++)
+            for (i = 0; i < G31_BITS; i++)
+            {
+                x = jump[k - 1][i];
+                v = 0;
+                for (j = 0; j < G31_BITS; j++)
+                    if ((x >> j) & 1)
+                        v = v ^ jump[k - 1][j];
+                jump[k][i] = v;
+            }
+        first = 0;
+    }
+
+    // Apply the matrix for each one bit of steps
+    steps = steps % G31_PERIOD;
+    for (k = 0; steps != 0; k++, steps = steps >> 1)
+    {
+        if ((steps & 1) == 0)
+            continue;
+        v = 0;
+        for (i = 0; i < G31_BITS; i++)
+            if ((n >> i) & 1)
+                v = v ^ jump[k][i];
+        n = v;
+    }
+
+    return(n);
+}
+
+//===========================================================================
+//=  Function to fill a buffer with Generator31() values                    =
+//=    - Input:  Buffer, number of values, and starting state n             =
+//=    - Output: Fills buf[0] to buf[num - 1] with the values that          =
+//=      Generator31() returns next from state n                            =
+//=    - j steps from state x (j up to G31_LANE) give (x >> j) with the     =
+//=      low j bits of f = x ^ (x >> 3) on top, so G31_LANE values come     =
+//=      from one state without a dependency chain.  Segments of G31_SEG    =
+//=      values start from g31_jump() and run in parallel with OpenMP.      =
+//===========================================================================
+void g31_fill(uint64_t *buf, uint64_t num, uint32_t n)
+{
+    uint64_t *out;               // Output for this segment
+    uint64_t len;                // Values in this segment
+    uint64_t i;                  // Index in this segment
+    uint32_t x;                  // State
+    uint32_t f;                  // New top bits for the next G31_LANE steps
+    long     seg;                // Segment counter
+    int      cnt;                // Values in this lane block
+    int      j;                  // Step in this lane block
+
+    // Build the jump matrices before the threads start
+    g31_jump(n, 0);
+
+    #pragma omp parallel for private(out, len, i, x, f, cnt, j) \
+        schedule(static)
+    for (seg = 0; seg < (long) ((num + G31_SEG - 1) / G31_SEG); seg++)
+    {
+        out = &buf[seg * G31_SEG];
+        len = num - seg * G31_SEG;
+        if (len > G31_SEG)
+            len = G31_SEG;
+        x = g31_jump(n, seg * G31_SEG);
+        for (i = 0; i < len; i = i + cnt)
+        {
+            cnt = (len - i < G31_LANE) ? (int) (len - i) : G31_LANE;
+            f = (x ^ (x >> 3)) & ((((uint32_t) 1) << G31_LANE) - 1);
+            for (j = 1; j <= cnt; j++)
+                out[i + j - 1] = (x >> j) | ((f << (31 - j)) & 0x7fffffff);
+            x = (uint32_t) out[i + cnt - 1];
+        }
+    }
+}
+
 //=========================================================================
 //= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
 //=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
@@ -163,3 +782,29 @@ int randInt(int seed)
     // Return a random integer value
     return(x);
 }
+
+//=========================================================================
+//= 64-bit splitmix RNG for generating uniform 64-bit random words        =
+//=   - x_n = x_(n-1) + 0x9e3779b97f4a7c15 and output is a mix of x_n     =
+//=   - Seeding follows randInt() (a seed greater than 0 sets the state)  =
+//=   - From S. Vigna, "splitmix64.c," http://prng.di.unimi.it/           =
+//=========================================================================
+uint64_t rand_val64(uint64_t seed)
+{
+    static uint64_t x;           // State of the RNG
+    uint64_t        z;           // Mixed output value
+
+    // Set the seed if argument is non-zero and then return zero
+    if (seed > 0)
+    {
+        x = seed;
+        return(0);
+    }
+
+    // Advance the state and mix it
+    x = x + 0x9e3779b97f4a7c15ULL;
+    z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return(z ^ (z >> 31));
+}